@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    AnalyserBenchmark.h
+    Created: 17 Oct 2026 1:04:18am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BenchmarkHelpers.h"
+#include "BenchmarkResults.h"
+#include "../../Source/Fifo.h"
+#include "../../Source/SingleChannelSampleFifo.h"
+
+// the analyser fifo the way it used to be: every sample goes in with setSample
+// and a full buffer gets copy assigned into a Fifo of buffers. kept here so the
+// block copying SingleChannelSampleFifo has something to be measured against
+struct PerSampleAnalyserFifo
+{
+    void prepare(int bufferSize)
+    {
+        bufferToFill.setSize(1, bufferSize, false, true, true);
+        audioBufferFifo.prepare(1, bufferSize);
+        fifoIndex = 0;
+    }
+
+    void update(const juce::AudioBuffer<float>& buffer, int channel)
+    {
+        auto* channelPtr = buffer.getReadPointer(channel);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            if (fifoIndex == bufferToFill.getNumSamples())
+            {
+                audioBufferFifo.push(bufferToFill);
+                fifoIndex = 0;
+            }
+
+            bufferToFill.setSample(0, fifoIndex, channelPtr[i]);
+            ++fifoIndex;
+        }
+    }
+
+    bool getAudioBuffer(juce::AudioBuffer<float>& buffer) { return audioBufferFifo.pull(buffer); }
+
+private:
+    int fifoIndex = 0;
+    Fifo<juce::AudioBuffer<float>> audioBufferFifo;
+    juce::AudioBuffer<float> bufferToFill;
+};
+
+// what pushToAnalyser costs the audio thread for both channels. only the
+// update() calls are timed, the editor side pulls everything out in between
+// like its timer would so neither fifo ever runs full and skips the work
+template<typename AnalyserFifo, typename UpdateFunction>
+double measureAnalyserNanosecondsPerSample(AnalyserFifo& left, AnalyserFifo& right,
+    const juce::AudioBuffer<float>& source, int blockSize, juce::int64 totalSamples,
+    UpdateFunction&& update)
+{
+    juce::AudioBuffer<float> block(source.getNumChannels(), blockSize);
+    juce::AudioBuffer<float> pulled;
+
+    auto sourceLength = source.getNumSamples() - blockSize;
+    int sourcePosition = 0;
+
+    juce::int64 ticks = 0;
+    juce::int64 processed = 0;
+
+    while (processed < totalSamples)
+    {
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
+            block.copyFrom(ch, 0, source, ch, sourcePosition, blockSize);
+
+        sourcePosition = (sourcePosition + blockSize) % sourceLength;
+
+        auto start = juce::Time::getHighResolutionTicks();
+        update(left, block, Channel::Left);
+        update(right, block, Channel::Right);
+        ticks += juce::Time::getHighResolutionTicks() - start;
+
+        while (left.getAudioBuffer(pulled)) { }
+        while (right.getAudioBuffer(pulled)) { }
+
+        processed += blockSize;
+    }
+
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / (double)processed;
+}
+
+inline void runAnalyserBenchmarks(BenchmarkResults& results)
+{
+    constexpr double sampleRate = 48000.0;
+    const auto totalSamples = static_cast<juce::int64>(sampleRate * 60.0);
+
+    juce::AudioBuffer<float> source(2, static_cast<int>(sampleRate));
+    fillWithNoise(source);
+
+    std::cout << "analyser fifos, 2 channels @ " << sampleRate << " Hz" << std::endl;
+    std::cout << "  block   per sample    block copy   speedup  (ns/sample)" << std::endl;
+
+    for (auto blockSize : getBenchmarkBlockSizes())
+    {
+        PerSampleAnalyserFifo oldLeft, oldRight;
+        oldLeft.prepare(blockSize);
+        oldRight.prepare(blockSize);
+
+        auto perSampleTime = measureAnalyserNanosecondsPerSample(oldLeft, oldRight, source, blockSize, totalSamples,
+            [](PerSampleAnalyserFifo& fifo, const juce::AudioBuffer<float>& buffer, Channel channel)
+            {
+                fifo.update(buffer, static_cast<int>(channel));
+            });
+
+        using RingFifo = SingleChannelSampleFifo<juce::AudioBuffer<float>>;
+
+        RingFifo left{ Channel::Left }, right{ Channel::Right };
+        left.prepare(blockSize);
+        right.prepare(blockSize);
+
+        auto blockCopyTime = measureAnalyserNanosecondsPerSample(left, right, source, blockSize, totalSamples,
+            [](RingFifo& fifo, const juce::AudioBuffer<float>& buffer, Channel)
+            {
+                fifo.update(buffer);
+            });
+
+        std::cout << juce::String(blockSize).paddedLeft(' ', 7)
+            << juce::String(perSampleTime, 3).paddedLeft(' ', 13)
+            << juce::String(blockCopyTime, 3).paddedLeft(' ', 14)
+            << juce::String(perSampleTime / blockCopyTime, 2).paddedLeft(' ', 9) << "x"
+            << std::endl;
+
+        auto& result = results.add("analyserFifo");
+        result.setProperty("sampleRate", sampleRate);
+        result.setProperty("blockSize", blockSize);
+        result.setProperty("perSampleNsPerSample", perSampleTime);
+        result.setProperty("blockCopyNsPerSample", blockCopyTime);
+    }
+
+    std::cout << std::endl;
+}
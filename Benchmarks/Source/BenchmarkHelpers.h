@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    BenchmarkHelpers.h
+    Created: 16 Oct 2026 11:48:10am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// fills a buffer with white noise, the same seed gives the same noise
+// so every benchmark processes exactly the same material
+template<typename SampleType>
+void fillWithNoise(juce::AudioBuffer<SampleType>& buffer, juce::int64 seed = 1234)
+{
+    juce::Random random(seed);
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* data = buffer.getWritePointer(ch);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            data[i] = static_cast<SampleType>(random.nextFloat() * 2.f - 1.f);
+    }
+}
+
+// runs 'process' on blocks of 'blockSize' samples until 'totalSamples' went through
+// and returns the average time it took per sample in nanoseconds.
+// the input is copied in fresh before every block so the filters never
+// end up processing their own output (and nothing decays into denormals)
+template<typename SampleType, typename ProcessFunction>
+double measureNanosecondsPerSample(const juce::AudioBuffer<SampleType>& source,
+    juce::AudioBuffer<SampleType>& work,
+    int blockSize,
+    juce::int64 totalSamples,
+    ProcessFunction&& process)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    auto numChannels = work.getNumChannels();
+    auto sourceLength = source.getNumSamples() - blockSize;
+    jassert(sourceLength > 0);
+
+    // warm up the caches and the branch predictors first
+    for (int i = 0; i < 16; ++i)
+        process(work, blockSize);
+
+    juce::int64 ticks = 0;
+    juce::int64 processed = 0;
+    int sourcePosition = 0;
+
+    while (processed < totalSamples)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            work.copyFrom(ch, 0, source, ch, sourcePosition, blockSize);
+
+        sourcePosition = (sourcePosition + blockSize) % sourceLength;
+
+        auto start = juce::Time::getHighResolutionTicks();
+        process(work, blockSize);
+        ticks += juce::Time::getHighResolutionTicks() - start;
+
+        processed += blockSize;
+    }
+
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / (double)processed;
+}
+
+// the block sizes hosts commonly use, 16 to 2048 samples
+inline juce::Array<int> getBenchmarkBlockSizes()
+{
+    return { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+}
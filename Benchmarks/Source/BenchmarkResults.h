@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    BenchmarkResults.h
+    Created: 16 Oct 2026 11:04:19pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// collects every number the benchmarks print so a run can be saved as json
+// and compared against the next one. each result is one flat object:
+// the name of the benchmark, what it ran with and the timings in nanoseconds
+struct BenchmarkResults
+{
+    // a new result, the caller sets its properties
+    juce::DynamicObject& add(const juce::String& benchmark)
+    {
+        auto* result = new juce::DynamicObject();
+        result->setProperty("benchmark", benchmark);
+
+        results.add(juce::var(result));
+        return *result;
+    }
+
+    // the results and the machine they came from
+    bool writeTo(const juce::File& file) const
+    {
+        auto* root = new juce::DynamicObject();
+        juce::var json(root);
+
+        root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("numCpus", juce::SystemStats::getNumCpus());
+        root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+        root->setProperty("results", results);
+
+        return file.replaceWithText(juce::JSON::toString(json));
+    }
+
+private:
+    juce::Array<juce::var> results;
+};
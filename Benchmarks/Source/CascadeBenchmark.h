@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    CascadeBenchmark.h
+    Created: 16 Oct 2026 11:55:42am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BenchmarkHelpers.h"
+#include "BenchmarkResults.h"
+#include "../../Source/CascadeEngine.h"
+
+// compares one MonoChain per channel (what the processor used to run for
+// left and right) against the CascadeEngine that packs the channels into simd lanes
+inline void runCascadeBenchmark(const ChainSettings& chainSettings, const juce::String& description, BenchmarkResults& results, double sampleRate, int numChannels = 2)
+{
+    CoefficientSet set;
+
+    for (auto band : { LowCut, Peak, HighCut })
+        designBand(set, band, chainSettings, sampleRate);
+
+    const auto blockSizes = getBenchmarkBlockSizes();
+    const auto totalSamples = static_cast<juce::int64>(sampleRate * 20.0);
+
+    juce::AudioBuffer<float> source(numChannels, static_cast<int>(sampleRate));
+    fillWithNoise(source);
+
+    std::cout << description << ", " << numChannels << " channels @ " << sampleRate << " Hz" << std::endl;
+    std::cout << "  block  N x MonoChain   CascadeEngine   speedup  (ns/sample)" << std::endl;
+
+    for (auto blockSize : blockSizes)
+    {
+        juce::AudioBuffer<float> work(numChannels, blockSize);
+
+        // the old way, one ProcessorChain per channel
+        juce::OwnedArray<MonoChain> chains;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            chains.add(new MonoChain());
+
+        juce::dsp::ProcessSpec spec;
+        spec.maximumBlockSize = static_cast<juce::uint32>(blockSize);
+        spec.numChannels = 1;
+        spec.sampleRate = sampleRate;
+
+        for (auto* chain : chains)
+        {
+            prepareCoefficientStorage(*chain);
+            chain->prepare(spec);
+            updateMonoChain(*chain, set);
+        }
+
+        auto monoChainTime = measureNanosecondsPerSample(source, work, blockSize, totalSamples,
+            [&](juce::AudioBuffer<float>& buffer, int numSamples)
+            {
+                juce::dsp::AudioBlock<float> block(buffer);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto channelBlock = block.getSingleChannelBlock((size_t)ch).getSubBlock(0, (size_t)numSamples);
+                    chains[ch]->process(juce::dsp::ProcessContextReplacing<float>(channelBlock));
+                }
+            });
+
+        // the new way, all the channels in one cascade
+        CascadeEngine cascade;
+        for (auto band : { LowCut, Peak, HighCut })
+            cascade.setBand(set, band);
+
+        auto cascadeTime = measureNanosecondsPerSample(source, work, blockSize, totalSamples,
+            [&](juce::AudioBuffer<float>& buffer, int numSamples)
+            {
+                cascade.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+            });
+
+        std::cout << juce::String(blockSize).paddedLeft(' ', 7)
+            << juce::String(monoChainTime, 3).paddedLeft(' ', 15)
+            << juce::String(cascadeTime, 3).paddedLeft(' ', 16)
+            << juce::String(monoChainTime / cascadeTime, 2).paddedLeft(' ', 9) << "x"
+            << std::endl;
+
+        auto& result = results.add("cascade");
+        result.setProperty("settings", description);
+        result.setProperty("sampleRate", sampleRate);
+        result.setProperty("numChannels", numChannels);
+        result.setProperty("blockSize", blockSize);
+        result.setProperty("monoChainNsPerSample", monoChainTime);
+        result.setProperty("cascadeNsPerSample", cascadeTime);
+    }
+
+    std::cout << std::endl;
+}
+
+inline void runCascadeBenchmarks(BenchmarkResults& results)
+{
+    ChainSettings allStages;
+    allStages.lowCutFreq = 80.f;
+    allStages.lowCutSlope = Slope_48;
+    allStages.peakFreq = 1000.f;
+    allStages.peakGainInDecibells = 6.f;
+    allStages.peakQ = 1.f;
+    allStages.highCutFreq = 12000.f;
+    allStages.highCutSlope = Slope_48;
+
+    ChainSettings defaults;
+    defaults.lowCutFreq = 20.f;
+    defaults.peakFreq = 750.f;
+    defaults.highCutFreq = 20000.f;
+
+    // only the low cut section and the peak are left running
+    auto lowCutOnly = defaults;
+    lowCutOnly.highCutBypassed = true;
+
+    for (auto sampleRate : { 48000.0, 96000.0 })
+    {
+        runCascadeBenchmark(allStages, "all 9 stages active", results, sampleRate);
+        runCascadeBenchmark(defaults, "default parameters (12 db/Oct cuts)", results, sampleRate);
+        runCascadeBenchmark(lowCutOnly, "12 db/Oct low cut, high cut bypassed", results, sampleRate);
+    }
+
+    // immersive layouts, mono up to 3rd order ambisonics
+    for (auto numChannels : { 1, 6, 12, 16 })
+        runCascadeBenchmark(allStages, "all 9 stages active", results, 48000.0, numChannels);
+}
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    DesignBenchmark.h
+    Created: 16 Oct 2026 5:48:33pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BenchmarkResults.h"
+#include "../../Source/CoefficientTables.h"
+
+// every benchmark writes its results here so the compiler can't throw the work away
+inline volatile float designBenchmarkSink = 0.f;
+
+// times one full redesign (low cut, peak and high cut) the way an automated
+// knob triggers it: the juce designers that allocate, the in-house designers
+// from BiquadDesign.h and the lookup tables from CoefficientTables.h
+template<typename DesignFunction>
+double measureNanosecondsPerDesign(int numDesigns, DesignFunction&& design)
+{
+    // the frequency moves every time so nothing can be hoisted out of the loop
+    auto frequencyAt = [](int i) { return 20.f + static_cast<float>(i % 19980); };
+
+    for (int i = 0; i < 1000; ++i)
+        design(frequencyAt(i));
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (int i = 0; i < numDesigns; ++i)
+        design(frequencyAt(i));
+
+    auto ticks = juce::Time::getHighResolutionTicks() - start;
+
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / (double)numDesigns;
+}
+
+inline void runDesignBenchmark(Slope slope, double sampleRate, BenchmarkResults& results)
+{
+    constexpr int numDesigns = 200000;
+
+    ChainSettings chainSettings;
+    chainSettings.lowCutSlope = slope;
+    chainSettings.highCutSlope = slope;
+    chainSettings.peakGainInDecibells = 6.f;
+    chainSettings.peakQ = 1.f;
+
+    float sink = 0.f;
+
+    auto juceTime = measureNanosecondsPerDesign(numDesigns, [&](float frequency)
+    {
+        chainSettings.lowCutFreq = chainSettings.peakFreq = chainSettings.highCutFreq = frequency;
+
+        auto lowCut = makeLowCutFilter(chainSettings, sampleRate);
+        auto peak = makePeakFilter(chainSettings, sampleRate);
+        auto highCut = makeHighCutFilter(chainSettings, sampleRate);
+
+        sink += lowCut[0]->getRawCoefficients()[0] + peak->getRawCoefficients()[0] + highCut[0]->getRawCoefficients()[0];
+    });
+
+    CoefficientSet set;
+
+    auto inHouseTime = measureNanosecondsPerDesign(numDesigns, [&](float frequency)
+    {
+        chainSettings.lowCutFreq = chainSettings.peakFreq = chainSettings.highCutFreq = frequency;
+
+        for (auto band : { LowCut, Peak, HighCut })
+            designBand(set, band, chainSettings, sampleRate);
+
+        sink += set.stages[0].b0 + set.stages[CoefficientSet::peakStage].b0;
+    });
+
+    auto tables = CoefficientTables::getFor(sampleRate);
+
+    auto tableTime = measureNanosecondsPerDesign(numDesigns, [&](float frequency)
+    {
+        chainSettings.lowCutFreq = chainSettings.peakFreq = chainSettings.highCutFreq = frequency;
+
+        for (auto band : { LowCut, Peak, HighCut })
+            designBand(set, band, chainSettings, *tables);
+
+        sink += set.stages[0].b0 + set.stages[CoefficientSet::peakStage].b0;
+    });
+
+    std::cout << juce::String((slope + 1) * 12).paddedLeft(' ', 6) << " db/Oct"
+        << juce::String(juceTime, 1).paddedLeft(' ', 12)
+        << juce::String(inHouseTime, 1).paddedLeft(' ', 12)
+        << juce::String(tableTime, 1).paddedLeft(' ', 12)
+        << juce::String(juceTime / inHouseTime, 2).paddedLeft(' ', 9) << "x"
+        << std::endl;
+
+    auto& result = results.add("design");
+    result.setProperty("sampleRate", sampleRate);
+    result.setProperty("slope", (slope + 1) * 12);
+    result.setProperty("juceNs", juceTime);
+    result.setProperty("inHouseNs", inHouseTime);
+    result.setProperty("tablesNs", tableTime);
+
+    designBenchmarkSink = sink;
+}
+
+// the juce designers from FilterDesign.h on their own (the response curve still uses them)
+inline void runFilterFactoryBenchmark(double sampleRate, BenchmarkResults& results)
+{
+    constexpr int numDesigns = 200000;
+
+    ChainSettings chainSettings;
+    chainSettings.peakGainInDecibells = 6.f;
+    chainSettings.peakQ = 1.f;
+
+    float sink = 0.f;
+
+    auto peakTime = measureNanosecondsPerDesign(numDesigns, [&](float frequency)
+    {
+        chainSettings.peakFreq = frequency;
+        sink += makePeakFilter(chainSettings, sampleRate)->getRawCoefficients()[0];
+    });
+
+    std::cout << "juce designers @ " << sampleRate << " Hz" << std::endl;
+    std::cout << "  makePeakFilter            " << juce::String(peakTime, 1).paddedLeft(' ', 10) << " ns" << std::endl;
+
+    auto& peakResult = results.add("makePeakFilter");
+    peakResult.setProperty("sampleRate", sampleRate);
+    peakResult.setProperty("ns", peakTime);
+
+    for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        chainSettings.lowCutSlope = slope;
+
+        auto lowCutTime = measureNanosecondsPerDesign(numDesigns, [&](float frequency)
+        {
+            chainSettings.lowCutFreq = frequency;
+            sink += makeLowCutFilter(chainSettings, sampleRate)[0]->getRawCoefficients()[0];
+        });
+
+        std::cout << "  makeLowCutFilter " << juce::String((slope + 1) * 12).paddedLeft(' ', 2) << " db/Oct"
+            << juce::String(lowCutTime, 1).paddedLeft(' ', 11) << " ns" << std::endl;
+
+        auto& lowCutResult = results.add("makeLowCutFilter");
+        lowCutResult.setProperty("sampleRate", sampleRate);
+        lowCutResult.setProperty("slope", (slope + 1) * 12);
+        lowCutResult.setProperty("ns", lowCutTime);
+    }
+
+    std::cout << std::endl;
+
+    designBenchmarkSink = sink;
+}
+
+inline void runDesignBenchmarks(BenchmarkResults& results)
+{
+    for (auto sampleRate : { 48000.0, 96000.0 })
+    {
+        std::cout << "designing all 3 bands @ " << sampleRate << " Hz" << std::endl;
+        std::cout << "         slope        juce    in-house      tables   speedup  (ns/design)" << std::endl;
+
+        for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+            runDesignBenchmark(slope, sampleRate, results);
+
+        std::cout << std::endl;
+    }
+
+    for (auto sampleRate : { 48000.0, 96000.0 })
+        runFilterFactoryBenchmark(sampleRate, results);
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AnalyserBenchmark.h"
+#include "CascadeBenchmark.h"
+#include "DesignBenchmark.h"
+#include "PrecisionBenchmark.h"
+#include "ProcessorBenchmark.h"
+#include "RealtimeCheck.h"
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // the processor expects a message manager, nothing here needs a window or an audio device
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+   #if SIMPLEEQ_REALTIME_CHECKS
+    // the checking build (the RealtimeCheck configuration) hooks the
+    // allocator, its timings would be off so it only runs the check
+    juce::ignoreUnused(argc, argv);
+    return runRealtimeChecks() ? 0 : 1;
+   #endif
+
+    juce::ArgumentList arguments(argc, argv);
+
+    if (arguments.containsOption("--help|-h"))
+    {
+        std::cout << "usage: SimpleEQBenchmarks [--suite=processor|cascade|design|precision|analyser] [--json=<file>]" << std::endl
+            << "  runs every suite unless one is picked and writes all the results" << std::endl
+            << "  to SimpleEQBenchmarks.json (or the --json file)" << std::endl;
+        return 0;
+    }
+
+    auto suite = arguments.getValueForOption("--suite");
+    auto shouldRun = [&suite](const juce::String& name) { return suite.isEmpty() || suite == name; };
+
+    BenchmarkResults results;
+
+    if (shouldRun("processor"))
+        runProcessorBenchmarks(results);
+
+    if (shouldRun("cascade"))
+        runCascadeBenchmarks(results);
+
+    if (shouldRun("design"))
+        runDesignBenchmarks(results);
+
+    if (shouldRun("precision"))
+        runPrecisionBenchmarks(results);
+
+    if (shouldRun("analyser"))
+        runAnalyserBenchmarks(results);
+
+    auto jsonFile = juce::File::getCurrentWorkingDirectory()
+        .getChildFile(arguments.containsOption("--json") ? arguments.getValueForOption("--json") : juce::String("SimpleEQBenchmarks.json"));
+
+    if (!results.writeTo(jsonFile))
+    {
+        std::cout << "can't write " << jsonFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "results written to " << jsonFile.getFullPathName() << std::endl;
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    PrecisionBenchmark.h
+    Created: 16 Oct 2026 9:52:36pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BenchmarkHelpers.h"
+#include "BenchmarkResults.h"
+#include "../../Source/CascadeEngine.h"
+
+// what the double precision paths cost next to the float cascade:
+// - float: the CascadeEngine as a 32 bit host runs it
+// - double: every stage in BasicCascadeEngine<double>, what a 64 bit host gets
+// - mixed: the low cut in double and the rest in float, including the
+//   conversion of the block to double and back like the processor does it
+inline void runPrecisionBenchmark(const ChainSettings& chainSettings, BenchmarkResults& results, double sampleRate, int numChannels = 2)
+{
+    CoefficientSet set;
+
+    for (auto band : { LowCut, Peak, HighCut })
+    {
+        designBand(set, band, chainSettings, sampleRate);
+        designPreciseBand(set, band, chainSettings, sampleRate);
+    }
+
+    const auto blockSizes = getBenchmarkBlockSizes();
+    const auto totalSamples = static_cast<juce::int64>(sampleRate * 20.0);
+
+    juce::AudioBuffer<float> source(numChannels, static_cast<int>(sampleRate));
+    juce::AudioBuffer<double> preciseSource(numChannels, static_cast<int>(sampleRate));
+    fillWithNoise(source);
+    fillWithNoise(preciseSource);
+
+    std::cout << "all 9 stages, " << numChannels << " channels @ " << sampleRate << " Hz" << std::endl;
+    std::cout << "  block       float      double       mixed  (ns/sample)" << std::endl;
+
+    for (auto blockSize : blockSizes)
+    {
+        juce::AudioBuffer<float> work(numChannels, blockSize);
+        juce::AudioBuffer<double> preciseWork(numChannels, blockSize);
+
+        CascadeEngine cascade;
+        BasicCascadeEngine<double> preciseCascade;
+
+        for (auto band : { LowCut, Peak, HighCut })
+        {
+            cascade.setBand(set, band);
+            preciseCascade.setBand(set, band);
+        }
+
+        auto floatTime = measureNanosecondsPerSample(source, work, blockSize, totalSamples,
+            [&](juce::AudioBuffer<float>& buffer, int numSamples)
+            {
+                cascade.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+            });
+
+        auto doubleTime = measureNanosecondsPerSample(preciseSource, preciseWork, blockSize, totalSamples,
+            [&](juce::AudioBuffer<double>& buffer, int numSamples)
+            {
+                preciseCascade.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+            });
+
+        // the low cut moves over to the double cascade
+        cascade.setBand(set, LowCut, false);
+        preciseCascade.setBand(set, Peak, false);
+        preciseCascade.setBand(set, HighCut, false);
+
+        auto mixedTime = measureNanosecondsPerSample(source, work, blockSize, totalSamples,
+            [&](juce::AudioBuffer<float>& buffer, int numSamples)
+            {
+                cascade.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* samples = buffer.getWritePointer(ch);
+                    auto* precise = preciseWork.getWritePointer(ch);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        precise[i] = static_cast<double>(samples[i]);
+                }
+
+                preciseCascade.process(preciseWork.getArrayOfWritePointers(), numChannels, numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* samples = buffer.getWritePointer(ch);
+                    auto* precise = preciseWork.getReadPointer(ch);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        samples[i] = static_cast<float>(precise[i]);
+                }
+            });
+
+        std::cout << juce::String(blockSize).paddedLeft(' ', 7)
+            << juce::String(floatTime, 3).paddedLeft(' ', 12)
+            << juce::String(doubleTime, 3).paddedLeft(' ', 12)
+            << juce::String(mixedTime, 3).paddedLeft(' ', 12)
+            << std::endl;
+
+        auto& result = results.add("precision");
+        result.setProperty("sampleRate", sampleRate);
+        result.setProperty("numChannels", numChannels);
+        result.setProperty("blockSize", blockSize);
+        result.setProperty("floatNsPerSample", floatTime);
+        result.setProperty("doubleNsPerSample", doubleTime);
+        result.setProperty("mixedNsPerSample", mixedTime);
+    }
+
+    std::cout << std::endl;
+}
+
+inline void runPrecisionBenchmarks(BenchmarkResults& results)
+{
+    ChainSettings allStages;
+    allStages.lowCutFreq = 30.f;
+    allStages.lowCutSlope = Slope_48;
+    allStages.peakFreq = 1000.f;
+    allStages.peakGainInDecibells = 6.f;
+    allStages.peakQ = 1.f;
+    allStages.highCutFreq = 12000.f;
+    allStages.highCutSlope = Slope_48;
+
+    for (auto sampleRate : { 48000.0, 192000.0 })
+        runPrecisionBenchmark(allStages, results, sampleRate);
+}
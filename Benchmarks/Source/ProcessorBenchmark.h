@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.h
+    Created: 16 Oct 2026 11:17:52pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BenchmarkHelpers.h"
+#include "BenchmarkResults.h"
+#include "DesignBenchmark.h"
+#include "../../Source/PluginProcessor.h"
+
+// what a host sees: SimpleEQAudioProcessor::processBlock with everything around
+// the filters (pulling the coefficients, the fast paths). no editor is open
+// so, like most instances in a session, it doesn't feed the analyser fifos.
+// the parameters are set the way a host automates them, prepareToPlay
+// designs them synchronously so every measurement starts from the right filters
+
+inline void setParameter(SimpleEQAudioProcessor& processor, const juce::String& parameterID, float value)
+{
+    auto* parameter = processor.apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+// 1 to 8192 samples, every power of two
+inline juce::Array<int> getProcessorBlockSizes()
+{
+    juce::Array<int> blockSizes;
+
+    for (int blockSize = 1; blockSize <= 8192; blockSize *= 2)
+        blockSizes.add(blockSize);
+
+    return blockSizes;
+}
+
+inline juce::Array<double> getProcessorSampleRates()
+{
+    return { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0, 352800.0, 384000.0 };
+}
+
+// every slope of both cuts with every bypass state of the three bands, 128 settings
+struct ProcessorSettings
+{
+    Slope lowCutSlope, highCutSlope;
+    bool lowCutBypassed, peakBypassed, highCutBypassed;
+};
+
+inline std::vector<ProcessorSettings> getProcessorSettings()
+{
+    std::vector<ProcessorSettings> settings;
+
+    for (auto lowCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+    {
+        for (auto highCutSlope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+        {
+            for (int bypassed = 0; bypassed < 8; ++bypassed)
+                settings.push_back({ lowCutSlope, highCutSlope, (bypassed & 1) != 0, (bypassed & 2) != 0, (bypassed & 4) != 0 });
+        }
+    }
+
+    return settings;
+}
+
+inline void applySettings(SimpleEQAudioProcessor& processor, const ProcessorSettings& settings)
+{
+    setParameter(processor, "LowCut Freq", 80.f);
+    setParameter(processor, "Peak Freq", 1000.f);
+    setParameter(processor, "Peak Gain", 6.f);
+    setParameter(processor, "Peak Q", 1.f);
+    setParameter(processor, "HighCut Freq", 12000.f);
+
+    setParameter(processor, "LowCut Slope", static_cast<float>(settings.lowCutSlope));
+    setParameter(processor, "HighCut Slope", static_cast<float>(settings.highCutSlope));
+    setParameter(processor, "LowCut Bypassed", settings.lowCutBypassed ? 1.f : 0.f);
+    setParameter(processor, "Peak Bypassed", settings.peakBypassed ? 1.f : 0.f);
+    setParameter(processor, "HighCut Bypassed", settings.highCutBypassed ? 1.f : 0.f);
+}
+
+// every block size and setting at one sample rate. all of them go into the results,
+// the console gets the fastest, the median and the slowest setting per block size
+inline void runProcessorBenchmark(SimpleEQAudioProcessor& processor, double sampleRate, BenchmarkResults& results)
+{
+    const auto numChannels = processor.getTotalNumOutputChannels();
+    const auto allSettings = getProcessorSettings();
+
+    juce::AudioBuffer<float> source(numChannels, static_cast<int>(sampleRate));
+    fillWithNoise(source);
+
+    juce::MidiBuffer midi;
+
+    std::cout << "processBlock, " << numChannels << " channels @ " << sampleRate << " Hz, "
+        << (int)allSettings.size() << " slope and bypass settings" << std::endl;
+    std::cout << "  block     fastest      median     slowest  (ns/sample)" << std::endl;
+
+    for (auto blockSize : getProcessorBlockSizes())
+    {
+        juce::AudioBuffer<float> work(numChannels, blockSize);
+
+        // tiny blocks are all overhead, big ones need a few blocks to mean anything
+        auto totalSamples = static_cast<juce::int64>(juce::jmax(65536, blockSize * 32));
+
+        std::vector<double> times;
+
+        for (const auto& settings : allSettings)
+        {
+            applySettings(processor, settings);
+
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            auto time = measureNanosecondsPerSample(source, work, blockSize, totalSamples,
+                [&](juce::AudioBuffer<float>& buffer, int)
+                {
+                    processor.processBlock(buffer, midi);
+                });
+
+            processor.releaseResources();
+            times.push_back(time);
+
+            auto& result = results.add("processBlock");
+            result.setProperty("sampleRate", sampleRate);
+            result.setProperty("blockSize", blockSize);
+            result.setProperty("numChannels", numChannels);
+            result.setProperty("lowCutSlope", (settings.lowCutSlope + 1) * 12);
+            result.setProperty("highCutSlope", (settings.highCutSlope + 1) * 12);
+            result.setProperty("lowCutBypassed", settings.lowCutBypassed);
+            result.setProperty("peakBypassed", settings.peakBypassed);
+            result.setProperty("highCutBypassed", settings.highCutBypassed);
+            result.setProperty("nsPerSample", time);
+        }
+
+        std::sort(times.begin(), times.end());
+
+        std::cout << juce::String(blockSize).paddedLeft(' ', 7)
+            << juce::String(times.front(), 3).paddedLeft(' ', 12)
+            << juce::String(times[times.size() / 2], 3).paddedLeft(' ', 12)
+            << juce::String(times.back(), 3).paddedLeft(' ', 12)
+            << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+// reading all the parameters into a ChainSettings, which every design starts with
+inline void runChainSettingsBenchmark(SimpleEQAudioProcessor& processor, BenchmarkResults& results)
+{
+    constexpr int numCalls = 1000000;
+    float sink = 0.f;
+
+    auto apvtsTime = measureNanosecondsPerDesign(numCalls, [&](float)
+    {
+        sink += getChainSettings(processor.apvts).peakFreq;
+    });
+
+    // what the CoefficientService does, the parameter pointers are looked up once
+    ChainParameters parameters(processor.apvts);
+
+    auto cachedTime = measureNanosecondsPerDesign(numCalls, [&](float)
+    {
+        sink += getChainSettings(parameters).peakFreq;
+    });
+
+    std::cout << "getChainSettings" << std::endl;
+    std::cout << "  from the apvts            " << juce::String(apvtsTime, 1).paddedLeft(' ', 10) << " ns" << std::endl;
+    std::cout << "  from ChainParameters      " << juce::String(cachedTime, 1).paddedLeft(' ', 10) << " ns" << std::endl;
+    std::cout << std::endl;
+
+    auto& result = results.add("getChainSettings");
+    result.setProperty("apvtsNs", apvtsTime);
+    result.setProperty("chainParametersNs", cachedTime);
+
+    designBenchmarkSink = sink;
+}
+
+inline void runProcessorBenchmarks(BenchmarkResults& results)
+{
+    SimpleEQAudioProcessor processor;
+
+    runChainSettingsBenchmark(processor, results);
+
+    for (auto sampleRate : getProcessorSampleRates())
+        runProcessorBenchmark(processor, sampleRate, results);
+}
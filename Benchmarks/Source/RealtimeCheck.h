@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    RealtimeCheck.h
+    Created: 17 Oct 2026 12:09:33am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BenchmarkHelpers.h"
+#include "../../Source/PluginProcessor.h"
+
+#if SIMPLEEQ_REALTIME_CHECKS
+
+// plays the host's audio thread: blocks of random sizes through processBlock
+// as fast as it can, every block gets fresh noise so nothing goes to sleep
+struct RealtimeCheckAudioThread : juce::Thread
+{
+    RealtimeCheckAudioThread(SimpleEQAudioProcessor& processorToUse, int maxBlockSize) :
+        juce::Thread("SimpleEQ Realtime Check Audio"),
+        processor(processorToUse),
+        maximumBlockSize(maxBlockSize)
+    {
+        auto numChannels = processor.getTotalNumOutputChannels();
+
+        buffer.setSize(numChannels, maximumBlockSize);
+        preciseBuffer.setSize(numChannels, maximumBlockSize);
+    }
+
+    void run() override
+    {
+        juce::Random random(1);
+        juce::MidiBuffer midi;
+
+        while (!threadShouldExit())
+        {
+            auto numSamples = 1 + random.nextInt(maximumBlockSize);
+
+            if (processor.isUsingDoublePrecision())
+                processBlock(preciseBuffer, numSamples, random, midi);
+            else
+                processBlock(buffer, numSamples, random, midi);
+
+            ++numBlocks;
+        }
+    }
+
+    std::atomic<int> numBlocks{ 0 };
+
+private:
+    SimpleEQAudioProcessor& processor;
+    const int maximumBlockSize;
+
+    juce::AudioBuffer<float> buffer;
+    juce::AudioBuffer<double> preciseBuffer;
+
+    template<typename SampleType>
+    void processBlock(juce::AudioBuffer<SampleType>& block, int numSamples, juce::Random& random, juce::MidiBuffer& midi)
+    {
+        // smaller than what was allocated, so this never reallocates
+        block.setSize(block.getNumChannels(), numSamples, false, false, true);
+
+        for (int ch = 0; ch < block.getNumChannels(); ++ch)
+        {
+            auto* samples = block.getWritePointer(ch);
+
+            for (int i = 0; i < numSamples; ++i)
+                samples[i] = static_cast<SampleType>(random.nextFloat() * 2.f - 1.f);
+        }
+
+        processor.processBlock(block, midi);
+    }
+};
+
+// runs the processor for a while with everything a session throws at it:
+// every parameter (the modes included) automated at random, presets loaded
+// and the analyser fifos read the way the editor reads them.
+// returns false if anything inside processBlock allocated or waited for a lock
+inline bool runRealtimeCheck(double sampleRate, int maxBlockSize, juce::AudioProcessor::ProcessingPrecision precision, double seconds)
+{
+    SimpleEQAudioProcessor processor;
+    juce::Random random(2);
+
+    // two presets to flip between: the defaults and everything at random
+    juce::MemoryBlock defaultPreset, randomPreset;
+    processor.getStateInformation(defaultPreset);
+
+    for (auto* parameter : processor.getParameters())
+        parameter->setValueNotifyingHost(random.nextFloat());
+
+    processor.getStateInformation(randomPreset);
+
+    processor.setProcessingPrecision(precision);
+    processor.setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+    processor.prepareToPlay(sampleRate, maxBlockSize);
+
+    // like an open editor with the analyser on
+    processor.addAnalyserConsumer();
+
+    RealtimeCheckAudioThread audioThread(processor, maxBlockSize);
+    audioThread.startThread();
+
+    juce::AudioBuffer<float> analyserBuffer;
+    auto violationsBefore = RealtimeSafety::getNumViolations();
+    auto end = juce::Time::getMillisecondCounterHiRes() + seconds * 1000.0;
+
+    for (int i = 0; juce::Time::getMillisecondCounterHiRes() < end; ++i)
+    {
+        const auto& parameters = processor.getParameters();
+        parameters[random.nextInt(parameters.size())]->setValueNotifyingHost(random.nextFloat());
+
+        if (i % 100 == 0)
+        {
+            const auto& preset = (i / 100) % 2 == 0 ? randomPreset : defaultPreset;
+            processor.setStateInformation(preset.getData(), static_cast<int>(preset.getSize()));
+        }
+
+        for (auto* fifo : { &processor.leftChannelFifo, &processor.rightChannelFifo })
+        {
+            while (fifo->getNumCompleteBuffersAvailiable() > 0)
+                fifo->getAudioBuffer(analyserBuffer);
+        }
+
+        juce::Thread::sleep(1);
+    }
+
+    audioThread.stopThread(1000);
+    processor.removeAnalyserConsumer();
+    processor.releaseResources();
+
+    auto numViolations = RealtimeSafety::getNumViolations() - violationsBefore;
+
+    std::cout << (precision == juce::AudioProcessor::doublePrecision ? "double" : "float") << " @ " << sampleRate << " Hz, blocks of 1 to "
+        << maxBlockSize << ": " << audioThread.numBlocks.load() << " blocks, " << numViolations << " violations" << std::endl;
+
+    return numViolations == 0;
+}
+
+inline bool runRealtimeChecks()
+{
+    auto passed = true;
+
+    for (auto precision : { juce::AudioProcessor::singlePrecision, juce::AudioProcessor::doublePrecision })
+    {
+        for (auto sampleRate : { 44100.0, 96000.0 })
+            passed = runRealtimeCheck(sampleRate, 512, precision, 10.0) && passed;
+    }
+
+    std::cout << (passed ? "processBlock is realtime safe" : "processBlock is NOT realtime safe") << std::endl;
+    return passed;
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    RealtimeHooks.cpp
+    Created: 16 Oct 2026 11:58:41pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/RealtimeSafety.h"
+
+#if SIMPLEEQ_REALTIME_CHECKS
+
+#if ! JUCE_LINUX
+ #error "the realtime checks replace glibc's allocator and mutex entry points, they only work on linux"
+#endif
+
+#include <pthread.h>
+#include <dlfcn.h>
+#include <cerrno>
+
+// the checking build replaces malloc and friends and pthread_mutex_lock for the
+// whole executable. every call still goes straight to glibc, but inside a
+// ScopedRealtimeSection it gets reported first. operator new and juce's
+// HeapBlock end up in malloc, CriticalSection and std::mutex in pthread_mutex_lock.
+// trylocks never wait so they are left alone.
+// this only works in an executable, a plugin loaded by a host can't replace
+// the host's allocator, so the markers in a plugin build do nothing
+
+namespace RealtimeSafety
+{
+    static std::atomic<int> numViolations{ 0 };
+
+    // building the report allocates, this keeps it from reporting itself
+    static thread_local bool reporting = false;
+
+    // the first few get a stack trace, after that they are only counted
+    static constexpr int maxReportedViolations = 16;
+
+    void reportViolation(const char* what)
+    {
+        if (!isInRealtimeContext() || reporting)
+            return;
+
+        reporting = true;
+
+        if (numViolations.fetch_add(1) < maxReportedViolations)
+        {
+            std::cerr << "realtime violation: " << what << " inside processBlock" << std::endl
+                << juce::SystemStats::getStackBacktrace() << std::endl;
+        }
+
+        reporting = false;
+    }
+
+    int getNumViolations()
+    {
+        return numViolations.load();
+    }
+
+    // glibc doesn't export an internal name for pthread_mutex_lock that can be
+    // linked against, so the real one is looked up the first time it is needed
+    using MutexLockFunction = int (*)(pthread_mutex_t*);
+    static std::atomic<MutexLockFunction> realMutexLock{ nullptr };
+
+    static MutexLockFunction getRealMutexLock()
+    {
+        auto function = realMutexLock.load();
+
+        if (function == nullptr)
+        {
+            function = reinterpret_cast<MutexLockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+            realMutexLock.store(function);
+        }
+
+        return function;
+    }
+}
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t size)
+    {
+        RealtimeSafety::reportViolation("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t numElements, size_t size)
+    {
+        RealtimeSafety::reportViolation("calloc");
+        return __libc_calloc(numElements, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        RealtimeSafety::reportViolation("realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        RealtimeSafety::reportViolation("memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        RealtimeSafety::reportViolation("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size)
+    {
+        RealtimeSafety::reportViolation("posix_memalign");
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free(void* pointer)
+    {
+        // freeing can take the allocator's locks just like allocating
+        if (pointer != nullptr)
+            RealtimeSafety::reportViolation("free");
+
+        __libc_free(pointer);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    {
+        RealtimeSafety::reportViolation("pthread_mutex_lock");
+        return RealtimeSafety::getRealMutexLock()(mutex);
+    }
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RenderWorker.h"
+
+static void printUsage()
+{
+    std::cout << "usage: SimpleEQRender --output=<folder> [--preset=<file>] [--block-size=512] [--threads=<n>]" << std::endl
+        << "                      [--chunk-seconds=60] <files...>" << std::endl
+        << "  renders wav, aiff and flac files through SimpleEQ into the output folder." << std::endl
+        << "  the preset is the plugin state, binary or xml. by default there is one" << std::endl
+        << "  worker (with its own processor) per cpu core. files longer than two chunks" << std::endl
+        << "  are split into chunks that render in parallel, each one pre-rolled over the" << std::endl
+        << "  filter tail so the stitched file matches a serial render (0 never splits)." << std::endl
+        << "  presets with Linear Phase or the State Variable topology on render in float" << std::endl
+        << "  and are never split" << std::endl;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // the message manager the processors expect, no window or audio device is ever opened
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList arguments(argc, argv);
+
+    if (arguments.containsOption("--help|-h") || !arguments.containsOption("--output"))
+    {
+        printUsage();
+        return 1;
+    }
+
+    RenderOptions options;
+    options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(arguments.getValueForOption("--output"));
+
+    if (arguments.containsOption("--block-size"))
+        options.blockSize = juce::jmax(1, arguments.getValueForOption("--block-size").getIntValue());
+
+    if (arguments.containsOption("--chunk-seconds"))
+        options.chunkSeconds = juce::jmax(0.0, arguments.getValueForOption("--chunk-seconds").getDoubleValue());
+
+    if (arguments.containsOption("--preset"))
+    {
+        auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(arguments.getValueForOption("--preset"));
+        options.preset = loadPreset(presetFile);
+
+        if (options.preset.isEmpty())
+        {
+            std::cout << presetFile.getFullPathName() << " is not a SimpleEQ preset" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!options.outputDirectory.createDirectory())
+    {
+        std::cout << "can't create " << options.outputDirectory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    juce::Array<juce::File> files;
+
+    for (int i = 0; i < arguments.size(); ++i)
+    {
+        const auto& argument = arguments[i];
+
+        // "--output folder" is the same as "--output=folder", the folder isn't a file to render
+        auto isOptionValue = i > 0 && arguments[i - 1].isLongOption() && !arguments[i - 1].text.contains("=");
+
+        if (!argument.isOption() && !isOptionValue)
+            files.add(argument.resolveAsFile());
+    }
+
+    if (files.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    auto numWorkers = juce::SystemStats::getNumCpus();
+
+    if (arguments.containsOption("--threads"))
+        numWorkers = arguments.getValueForOption("--threads").getIntValue();
+
+    // long files get split up so there can be more workers than files
+    numWorkers = juce::jmax(1, numWorkers);
+
+    juce::OwnedArray<SimpleEQAudioProcessor> processors;
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto* processor = processors.add(new SimpleEQAudioProcessor());
+
+        if (!options.preset.isEmpty())
+            processor->setStateInformation(options.preset.getData(), static_cast<int>(options.preset.getSize()));
+    }
+
+    std::cout << "rendering " << files.size() << " files with " << numWorkers << " workers, "
+        << options.blockSize << " sample blocks" << std::endl;
+
+    RenderQueue queue(files, options, *processors[0]);
+
+    juce::OwnedArray<RenderWorker> workers;
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add(new RenderWorker(i, *processors[i], queue, options));
+
+    auto start = juce::Time::getMillisecondCounterHiRes();
+
+    for (auto* worker : workers)
+        worker->startThread();
+
+    for (auto* worker : workers)
+        worker->waitForThreadToExit(-1);
+
+    auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+
+    // the workers run side by side so the total is the audio of every
+    // file over the wall clock time, not the sum of the per file multiples
+    double audioSeconds = 0.0;
+    int numFailed = 0;
+
+    for (int i = 0; i < queue.getNumFiles(); ++i)
+    {
+        const auto& result = queue.getResult(i);
+
+        if (result.wasOk())
+            audioSeconds += result.audioSeconds;
+        else
+            ++numFailed;
+    }
+
+    std::cout << files.size() - numFailed << " of " << files.size() << " files, "
+        << juce::String(audioSeconds, 1) << " s of audio in " << juce::String(wallSeconds, 2) << " s, "
+        << juce::String(wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0, 1) << "x realtime" << std::endl;
+
+    // the block loads against the realtime budget, what the plugin would cost live
+    for (int i = 0; i < workers.size(); ++i)
+    {
+        const auto& load = workers[i]->getLoadStatistics();
+
+        std::cout << "worker " << i << ": " << load.numBlocks << " blocks, load p50 "
+            << juce::String(load.p50 * 100.0, 2) << "% p99 " << juce::String(load.p99 * 100.0, 2) << "% max "
+            << juce::String(load.max * 100.0, 2) << "%, " << load.numOverBudget << " over budget" << std::endl;
+    }
+
+    // the workers share one set of tables per sample rate
+    std::cout << "coefficient tables (last sample rate): "
+        << static_cast<int>(processors[0]->getCoefficientTableMemoryBytes() / 1024) << " kB" << std::endl;
+
+    workers.clear();
+    processors.clear();
+
+    return numFailed == 0 ? 0 : 1;
+}
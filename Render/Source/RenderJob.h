@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    RenderJob.h
+    Created: 16 Oct 2026 10:12:37pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "../../Source/PluginProcessor.h"
+
+// what every file gets rendered with
+struct RenderOptions
+{
+    juce::File outputDirectory;
+
+    // the state the processors get through setStateInformation,
+    // empty leaves the parameters at their defaults
+    juce::MemoryBlock preset;
+
+    int blockSize = 512;
+
+    // files longer than two chunks get split up so all the workers can
+    // render them at the same time (see RenderQueue), 0 never splits
+    double chunkSeconds = 60.0;
+};
+
+struct RenderResult
+{
+    juce::File input, output;
+    juce::String error;
+
+    double audioSeconds = 0.0;
+    double renderSeconds = 0.0;
+
+    bool wasOk() const { return error.isEmpty(); }
+
+    // how many times faster than realtime the file went through
+    double getRealtimeMultiple() const
+    {
+        return renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0;
+    }
+};
+
+// a preset is either what getStateInformation wrote or the same tree saved as xml,
+// returns an empty block if the file doesn't hold a valid state
+inline juce::MemoryBlock loadPreset(const juce::File& file)
+{
+    juce::MemoryBlock state;
+
+    if (auto xml = juce::parseXML(file))
+    {
+        auto tree = juce::ValueTree::fromXml(*xml);
+
+        if (tree.isValid())
+        {
+            juce::MemoryOutputStream mos(state, false);
+            tree.writeToStream(mos);
+        }
+
+        return state;
+    }
+
+    if (file.loadFileAsData(state) && juce::ValueTree::readFromData(state.getData(), state.getSize()).isValid())
+        return state;
+
+    return {};
+}
+
+// wav and aiff files get mapped into memory, the reader then converts the samples
+// straight from the mapped pages into the processing buffer without any stream
+// or read buffer in between. flac is compressed so it can only be streamed
+inline std::unique_ptr<juce::AudioFormatReader> createInputReader(juce::AudioFormatManager& formats, const juce::File& file)
+{
+    if (auto* format = formats.findFormatForFileExtension(file.getFileExtension()))
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+        if (mapped != nullptr && mapped->mapEntireFile())
+            return mapped;
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+}
+
+// the output gets the format and (where the format allows it) the bit depth of the input
+inline std::unique_ptr<juce::AudioFormatWriter> createOutputWriter(juce::AudioFormatManager& formats,
+    const juce::AudioFormatReader& reader,
+    const juce::File& file)
+{
+    auto* format = formats.findFormatForFileExtension(file.getFileExtension());
+
+    if (format == nullptr)
+        return nullptr;
+
+    auto bitsPerSample = static_cast<int>(reader.bitsPerSample);
+    auto possibleDepths = format->getPossibleBitDepths();
+
+    if (!possibleDepths.contains(bitsPerSample) && !possibleDepths.isEmpty())
+        bitsPerSample = possibleDepths.getLast();
+
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+
+    if (stream == nullptr)
+        return nullptr;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+        reader.sampleRate,
+        reader.numChannels,
+        bitsPerSample,
+        reader.metadataValues,
+        0));
+
+    // the writer owns the stream from here on
+    if (writer != nullptr)
+        stream.release();
+
+    return writer;
+}
+
+// gets the processor ready for a file: its channel count, its sample rate and
+// double precision. the render has no deadline so the iir filters run in double,
+// the low cuts are a lot more accurate that way (see PrecisionBenchmark) and it is
+// what lets the chunks of a long file line up with a serial render (see renderRange).
+// the linear phase mode and the state variable topology only run in float, a preset
+// with one of them on renders in float and in one piece (see canRenderInChunks).
+// returns an error message or an empty string
+inline juce::String prepareForFile(SimpleEQAudioProcessor& processor, const juce::AudioFormatReader& reader, int blockSize)
+{
+    auto numChannels = static_cast<int>(reader.numChannels);
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+    layout.outputBuses.add(juce::AudioChannelSet::canonicalChannelSet(numChannels));
+
+    if (!processor.setBusesLayout(layout))
+        return juce::String(numChannels) + " channels are not supported";
+
+    processor.setNonRealtime(true);
+
+    auto floatOnly = processor.apvts.getRawParameterValue("Linear Phase")->load() > 0.5f
+        || processor.apvts.getRawParameterValue("Filter Topology")->load() > 0.5f;
+    processor.setProcessingPrecision(floatOnly ? juce::AudioProcessor::singlePrecision
+                                               : juce::AudioProcessor::doublePrecision);
+    processor.setRateAndBufferSizeDetails(reader.sampleRate, blockSize);
+    processor.prepareToPlay(reader.sampleRate, blockSize);
+
+    return {};
+}
+
+// whether the chunks of a file rendered with this preset match a serial render.
+// in double the pre-roll lets the iir state settle below -120 dB, in float nothing
+// takes the chunks below the rounding noise of the filters (and the convolver's
+// partitions fall differently relative to the chunk starts), so a float render
+// goes in one stream. call it after prepareForFile
+inline bool canRenderInChunks(const SimpleEQAudioProcessor& processor)
+{
+    return processor.isUsingDoublePrecision() && processor.getTailLengthSeconds() < maxTailSeconds;
+}
+
+// how far before its first sample a chunk has to start the processor so its
+// output matches a serial render. the iir cascade needs its tail: by then whatever
+// the missing history left in the filters has decayed below -120 dB (tailThreshold).
+// the linear phase fir only reaches back half its length and the latency is more than that
+inline juce::int64 getPreRollSamples(const SimpleEQAudioProcessor& processor, double sampleRate)
+{
+    auto tailSamples = static_cast<juce::int64>(std::ceil(processor.getTailLengthSeconds() * sampleRate));
+    return tailSamples + 2 * processor.getProcessingLatencySamples();
+}
+
+// runs a block of the file through the processor in place,
+// by way of the double buffer when it was prepared for double precision
+inline void processFileBlock(SimpleEQAudioProcessor& processor,
+    juce::AudioBuffer<float>& fileBuffer,
+    juce::AudioBuffer<double>& preciseBuffer,
+    juce::MidiBuffer& midi)
+{
+    if (processor.isUsingDoublePrecision())
+    {
+        preciseBuffer.makeCopyOf(fileBuffer, true);
+        processor.processBlock(preciseBuffer, midi);
+        fileBuffer.makeCopyOf(preciseBuffer, true);
+    }
+    else
+    {
+        processor.processBlock(fileBuffer, midi);
+    }
+
+    midi.clear();
+}
+
+// streams the input samples [start, start + length) through a processor that
+// prepareForFile got ready and hands the output to write(buffer, startSample, numSamples) in order.
+// a chunk that doesn't start at the top of the file runs the processor over the
+// pre-roll before it first and throws that output away.
+// with the linear phase mode on the latency is taken off the front (and made up
+// with silence at the end) so the output lines up with the input
+template<typename WriteFunction>
+juce::String renderRange(SimpleEQAudioProcessor& processor,
+    juce::AudioFormatReader& reader,
+    juce::int64 start,
+    juce::int64 length,
+    int blockSize,
+    WriteFunction&& write)
+{
+    auto numChannels = static_cast<int>(reader.numChannels);
+
+    juce::AudioBuffer<float> fileBuffer(numChannels, blockSize);
+    juce::AudioBuffer<double> preciseBuffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+
+    // one block of silence picks the mode up (that is when the latency is known)
+    // and changes nothing else, a fresh processor only holds zeros anyway.
+    // every render starts like this so serial renders and chunks stay the same
+    fileBuffer.clear();
+    processFileBlock(processor, fileBuffer, preciseBuffer, midi);
+
+    auto preRoll = juce::jmin(start, getPreRollSamples(processor, reader.sampleRate));
+    auto samplesToSkip = preRoll + processor.getProcessingLatencySamples();
+
+    auto readPosition = start - preRoll;
+    juce::int64 written = 0;
+
+    while (written < length)
+    {
+        // past the end of the input the processor keeps getting silence
+        // until the delayed output is all out
+        auto numInputSamples = static_cast<int>(juce::jlimit<juce::int64>(0, blockSize, reader.lengthInSamples - readPosition));
+
+        fileBuffer.clear();
+
+        if (numInputSamples > 0)
+            reader.read(&fileBuffer, 0, numInputSamples, readPosition, true, true);
+
+        readPosition += blockSize;
+
+        processFileBlock(processor, fileBuffer, preciseBuffer, midi);
+
+        auto offset = static_cast<int>(juce::jmin<juce::int64>(blockSize, samplesToSkip));
+        samplesToSkip -= offset;
+
+        auto numOutputSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize - offset, length - written));
+
+        if (numOutputSamples <= 0)
+            continue;
+
+        if (!write(fileBuffer, offset, numOutputSamples))
+            return "writing the output failed";
+
+        written += numOutputSamples;
+    }
+
+    return {};
+}
@@ -0,0 +1,292 @@
+/*
+  ==============================================================================
+
+    RenderWorker.h
+    Created: 16 Oct 2026 10:31:05pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <map>
+#include "RenderJob.h"
+
+// one input file and everything its chunks share
+struct FileRender
+{
+    RenderResult result;
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    int numChunks = 0;
+    double sampleRate = 0.0;
+
+    // the chunks can finish in any order, a finished chunk waits
+    // here until every chunk before it has been written
+    juce::CriticalSection writeLock;
+    std::map<int, juce::AudioBuffer<float>> finishedChunks;
+    int numChunksDone = 0;
+    double startTime = 0.0;
+};
+
+// a piece of a file, the whole file unless it got split up
+struct RenderJob
+{
+    FileRender* file = nullptr;
+    int chunk = 0;
+    juce::int64 start = 0, length = 0;
+};
+
+// every job of every file, in order. a job is claimed with a single atomic increment
+// so the workers go through the chunks of a file roughly together and only a few
+// finished chunks ever wait for the one before them
+struct RenderQueue
+{
+    // opens every file and works out its chunks, on the message thread.
+    // the probe is one of the processors, it tells us how long the tail is
+    // for the preset at the file's sample rate
+    RenderQueue(const juce::Array<juce::File>& inputs, const RenderOptions& options, SimpleEQAudioProcessor& probe)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        for (const auto& input : inputs)
+        {
+            auto* file = files.add(new FileRender());
+            file->result.input = input;
+            file->result.output = options.outputDirectory.getChildFile(input.getFileName());
+            file->result.error = planFile(*file, formats, options, probe);
+
+            if (!file->result.wasOk())
+                report(*file);
+        }
+    }
+
+    // nullptr once every job has been claimed
+    const RenderJob* claimNextJob()
+    {
+        auto index = nextJob.fetch_add(1);
+        return index < static_cast<int>(jobs.size()) ? &jobs[static_cast<size_t>(index)] : nullptr;
+    }
+
+    // a chunk is done: its output gets written out (or parked until the chunks before it are)
+    void finishChunk(const RenderJob& job, juce::AudioBuffer<float>&& output, const juce::String& error)
+    {
+        auto& file = *job.file;
+        const juce::ScopedLock sl(file.writeLock);
+
+        if (error.isNotEmpty() && file.result.wasOk())
+            file.result.error = error;
+
+        file.finishedChunks[job.chunk] = std::move(output);
+
+        for (auto it = file.finishedChunks.begin(); it != file.finishedChunks.end() && it->first == file.numChunksDone;)
+        {
+            if (file.result.wasOk() && file.numChunks > 1
+                && !file.writer->writeFromAudioSampleBuffer(it->second, 0, it->second.getNumSamples()))
+                file.result.error = "writing the output failed";
+
+            it = file.finishedChunks.erase(it);
+            ++file.numChunksDone;
+        }
+
+        if (file.numChunksDone == file.numChunks)
+            finishFile(file);
+    }
+
+    void startChunk(const RenderJob& job)
+    {
+        const juce::ScopedLock sl(job.file->writeLock);
+
+        if (job.file->startTime == 0.0)
+            job.file->startTime = juce::Time::getMillisecondCounterHiRes();
+    }
+
+    int getNumFiles() const { return files.size(); }
+    const RenderResult& getResult(int index) const { return files[index]->result; }
+
+private:
+    juce::OwnedArray<FileRender> files;
+    std::vector<RenderJob> jobs;
+    std::atomic<int> nextJob{ 0 };
+
+    juce::CriticalSection printLock;
+
+    juce::String planFile(FileRender& file, juce::AudioFormatManager& formats, const RenderOptions& options, SimpleEQAudioProcessor& probe)
+    {
+        if (file.result.output == file.result.input)
+            return "the output would overwrite the input";
+
+        auto reader = createInputReader(formats, file.result.input);
+
+        if (reader == nullptr)
+            return "can't read the file";
+
+        file.writer = createOutputWriter(formats, *reader, file.result.output);
+
+        if (file.writer == nullptr)
+            return "can't write " + file.result.output.getFullPathName();
+
+        auto length = reader->lengthInSamples;
+        auto chunkLength = static_cast<juce::int64>(options.chunkSeconds * reader->sampleRate);
+
+        file.sampleRate = reader->sampleRate;
+        file.result.audioSeconds = static_cast<double>(length) / reader->sampleRate;
+        file.numChunks = 1;
+
+        if (chunkLength > 0 && length >= 2 * chunkLength)
+        {
+            auto error = prepareForFile(probe, *reader, options.blockSize);
+
+            if (error.isNotEmpty())
+                return error;
+
+            // a tail that hit the cap (see maxTailSeconds) might ring on for longer
+            // than any pre-roll and a float only preset can't match a serial render,
+            // a file like that is rendered in one go
+            if (canRenderInChunks(probe))
+                file.numChunks = static_cast<int>((length + chunkLength - 1) / chunkLength);
+
+            probe.releaseResources();
+        }
+
+        for (int chunk = 0; chunk < file.numChunks; ++chunk)
+        {
+            RenderJob job;
+            job.file = &file;
+            job.chunk = chunk;
+            job.start = file.numChunks == 1 ? 0 : chunk * chunkLength;
+            job.length = file.numChunks == 1 ? length : juce::jmin(chunkLength, length - job.start);
+
+            jobs.push_back(job);
+        }
+
+        return {};
+    }
+
+    void finishFile(FileRender& file)
+    {
+        file.writer.reset();
+        file.result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - file.startTime) / 1000.0;
+
+        if (!file.result.wasOk())
+            file.result.output.deleteFile();
+
+        report(file);
+    }
+
+    void report(const FileRender& file)
+    {
+        const juce::ScopedLock sl(printLock);
+        const auto& result = file.result;
+
+        if (result.wasOk())
+            std::cout << result.output.getFileName() << ": " << juce::String(result.audioSeconds, 1) << " s of audio in "
+                << file.numChunks << (file.numChunks == 1 ? " piece, " : " pieces, ") << juce::String(result.renderSeconds, 2) << " s, "
+                << juce::String(result.getRealtimeMultiple(), 1) << "x realtime" << std::endl;
+        else
+            std::cout << result.input.getFileName() << ": " << result.error << std::endl;
+    }
+};
+
+// one thread with a processor of its own, it renders jobs off the
+// queue one after the other until there are none left.
+// the processor is created (and has its preset set) on the message thread,
+// the worker only prepares it and calls processBlock like a host would.
+// a file in one piece is written straight to its writer, a chunk
+// collects its output and hands it to the queue to stitch together
+struct RenderWorker : juce::Thread
+{
+    RenderWorker(int index, SimpleEQAudioProcessor& processorToUse, RenderQueue& queueToUse, const RenderOptions& renderOptions) :
+        juce::Thread("SimpleEQ Render Worker " + juce::String(index)),
+        processor(processorToUse),
+        queue(queueToUse),
+        options(renderOptions)
+    {
+        formats.registerBasicFormats();
+    }
+
+    void run() override
+    {
+        while (auto* job = queue.claimNextJob())
+        {
+            if (threadShouldExit())
+                return;
+
+            queue.startChunk(*job);
+
+            juce::AudioBuffer<float> output;
+            auto error = renderJob(*job, output);
+
+            queue.finishChunk(*job, std::move(output), error);
+        }
+    }
+
+    // the block loads of every chunk this worker rendered, the same counters the
+    // plugin shows in its cpu overlay. every chunk prepares the processor again so
+    // the percentiles are the worst chunk's, the counts and the max cover all of them
+    const BlockLoadMeter::Statistics& getLoadStatistics() const { return loadStatistics; }
+
+private:
+    SimpleEQAudioProcessor& processor;
+    RenderQueue& queue;
+    const RenderOptions& options;
+
+    juce::AudioFormatManager formats;
+
+    BlockLoadMeter::Statistics loadStatistics;
+
+    void addLoadStatistics(const BlockLoadMeter::Statistics& chunk)
+    {
+        loadStatistics.numBlocks += chunk.numBlocks;
+        loadStatistics.numOverBudget += chunk.numOverBudget;
+        loadStatistics.p50 = juce::jmax(loadStatistics.p50, chunk.p50);
+        loadStatistics.p99 = juce::jmax(loadStatistics.p99, chunk.p99);
+        loadStatistics.max = juce::jmax(loadStatistics.max, chunk.max);
+    }
+
+    juce::String renderJob(const RenderJob& job, juce::AudioBuffer<float>& output)
+    {
+        // every chunk opens the file again, mapping it is lazy so
+        // only the pages the chunk actually reads get loaded
+        auto reader = createInputReader(formats, job.file->result.input);
+
+        if (reader == nullptr)
+            return "can't read the file";
+
+        auto error = prepareForFile(processor, *reader, options.blockSize);
+
+        if (error.isNotEmpty())
+            return error;
+
+        if (job.file->numChunks == 1)
+        {
+            // nobody else writes to this file
+            error = renderRange(processor, *reader, job.start, job.length, options.blockSize,
+                [&job](const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+                {
+                    return job.file->writer->writeFromAudioSampleBuffer(buffer, startSample, numSamples);
+                });
+        }
+        else
+        {
+            output.setSize(static_cast<int>(reader->numChannels), static_cast<int>(job.length));
+            int position = 0;
+
+            error = renderRange(processor, *reader, job.start, job.length, options.blockSize,
+                [&output, &position](const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+                {
+                    for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                        output.copyFrom(ch, position, buffer, ch, startSample, numSamples);
+
+                    position += numSamples;
+                    return true;
+                });
+        }
+
+        addLoadStatistics(processor.getBlockLoadStatistics());
+
+        processor.releaseResources();
+        return error;
+    }
+};
@@ -26,7 +26,15 @@ struct AnalyserPathGenerator
 
         int numBins = (int)fftSize / 2;
 
-        PathType p;
+        // the path gets built right in the next slot of the fifo,
+        // clearing it keeps the space the last path there used
+        auto* slot = pathFifo.acquireWrite();
+
+        if (slot == nullptr)
+            return;
+
+        auto& p = *slot;
+        p.clear();
         p.preallocateSpace(3 * (int)fftBounds.getWidth());
 
         auto map = [bottom, top, negativeInfinity](float v)
@@ -61,7 +69,7 @@ struct AnalyserPathGenerator
             }
 
         }
-        pathFifo.push(p);
+        pathFifo.commitWrite();
 
     }
 
@@ -76,6 +84,22 @@ struct AnalyserPathGenerator
         return pathFifo.pull(path);
     }
 
+    // swaps the oldest path in the fifo with 'path', so the slot
+    // gets the old one's storage back instead of anything being copied
+    bool swapPath(PathType& path)
+    {
+        auto* slot = pathFifo.acquireRead();
+
+        if (slot == nullptr)
+            return false;
+
+        path.swapWithPath(*slot);
+        pathFifo.releaseRead();
+        return true;
+    }
+
+    void discardAll() { pathFifo.discardAll(); }
+
 private:
     Fifo<PathType> pathFifo;
 
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    AnalyserWorkerPool.h
+    Created: 17 Oct 2026 1:52:09am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <vector>
+
+// a few background threads shared by every open editor of every plugin instance
+// that do the analyser's ffts and paths, so the message thread only picks up
+// the finished paths. get it through a juce::SharedResourcePointer.
+//
+// every client has at most one job waiting: submitting again while the last one
+// hasn't started just moves its deadline and priority on, the newer request
+// covers the older one anyway. the workers take the jobs of visible editors
+// first and then the ones with the closest deadline, a job whose deadline
+// passed before a worker got to it is dropped (the next one catches up)
+struct AnalyserWorkerPool
+{
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        // runs on one of the workers, never on two at the same time
+        virtual void runAnalysis() = 0;
+    };
+
+    AnalyserWorkerPool()
+    {
+        auto numWorkers = juce::jlimit(1, maxWorkers, juce::SystemStats::getNumCpus() / 2);
+
+        for (int i = 0; i < numWorkers; ++i)
+            workers.add(new Worker(*this, i))->startThread();
+    }
+
+    ~AnalyserWorkerPool()
+    {
+        for (auto* worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (int i = 0; i < workers.size(); ++i)
+            workAvailable.signal();
+
+        for (auto* worker : workers)
+            worker->stopThread(1000);
+    }
+
+    // message thread, the job should be done by 'deadlineMs' on the
+    // juce::Time::getMillisecondCounterHiRes() clock or not at all
+    void submit(Client& client, bool visible, double deadlineMs)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+
+            auto pending = std::find_if(jobs.begin(), jobs.end(), [&client](const Job& job) { return job.client == &client; });
+
+            if (pending != jobs.end())
+            {
+                pending->visible = visible;
+                pending->deadlineMs = deadlineMs;
+            }
+            else
+            {
+                jobs.push_back({ &client, visible, deadlineMs });
+            }
+        }
+
+        workAvailable.signal();
+    }
+
+    // throws away the client's waiting job and waits until no worker is running it,
+    // after this the client can be changed or deleted. not from a worker
+    void cancel(Client& client)
+    {
+        for (;;)
+        {
+            {
+                const juce::ScopedLock sl(lock);
+
+                jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [&client](const Job& job) { return job.client == &client; }),
+                    jobs.end());
+
+                if (!running.contains(&client))
+                    return;
+            }
+
+            juce::Thread::sleep(1);
+        }
+    }
+
+    int getNumWorkers() const { return workers.size(); }
+
+    // how many jobs went past their deadline before anyone got to them
+    juce::uint64 getNumDroppedJobs() const { return droppedJobs.load(); }
+
+private:
+    static constexpr int maxWorkers = 4;
+
+    struct Job
+    {
+        Client* client;
+        bool visible;
+        double deadlineMs;
+    };
+
+    struct Worker : juce::Thread
+    {
+        Worker(AnalyserWorkerPool& poolToUse, int index) :
+            juce::Thread("SimpleEQ Analyser " + juce::String(index)),
+            pool(poolToUse)
+        {
+        }
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                if (auto* client = pool.takeNextJob())
+                {
+                    client->runAnalysis();
+                    pool.finishJob(client);
+                }
+                else
+                {
+                    pool.workAvailable.wait(100);
+                }
+            }
+        }
+
+        AnalyserWorkerPool& pool;
+    };
+
+    juce::CriticalSection lock;
+    std::vector<Job> jobs;
+    juce::Array<Client*> running;
+    juce::WaitableEvent workAvailable;
+    std::atomic<juce::uint64> droppedJobs{ 0 };
+
+    juce::OwnedArray<Worker> workers;
+
+    Client* takeNextJob()
+    {
+        const juce::ScopedLock sl(lock);
+        auto now = juce::Time::getMillisecondCounterHiRes();
+
+        auto numBefore = jobs.size();
+        jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [now](const Job& job) { return job.deadlineMs < now; }),
+            jobs.end());
+        droppedJobs.fetch_add(numBefore - jobs.size());
+
+        auto next = jobs.end();
+
+        for (auto job = jobs.begin(); job != jobs.end(); ++job)
+        {
+            // a client that is still running its last job waits its turn
+            if (running.contains(job->client))
+                continue;
+
+            if (next == jobs.end()
+                || (job->visible && !next->visible)
+                || (job->visible == next->visible && job->deadlineMs < next->deadlineMs))
+                next = job;
+        }
+
+        if (next == jobs.end())
+            return nullptr;
+
+        auto* client = next->client;
+        jobs.erase(next);
+        running.add(client);
+
+        // there is more, wake up another worker for it
+        if (!jobs.empty())
+            workAvailable.signal();
+
+        return client;
+    }
+
+    void finishJob(Client* client)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            running.removeFirstMatchingValue(client);
+        }
+
+        // a job of this client might have been waiting for it to finish
+        workAvailable.signal();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(AnalyserWorkerPool)
+};
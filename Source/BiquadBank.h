@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    BiquadBank.h
+    Created: 16 Oct 2026 1:14:08pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include "CoefficientSet.h"
+
+// every coefficient of the 9 stage cascade in flat arrays
+// (structure of arrays) so there are no CoefficientsPtr's to chase
+// and the whole bank fits in a handful of cache lines.
+// the precision comes from the register, SIMDRegister<float> or SIMDRegister<double>.
+// the bank is shared by every group of channels, the filter state
+// lives next to each group in a BiquadState
+template<typename Register>
+struct BiquadBank
+{
+    static constexpr int numStages = CoefficientSet::numStages;
+
+    std::array<Register, numStages> b0, b1, b2, a1, a2;
+    std::array<bool, numStages> active{};
+
+    // what gets added to every coefficient after each sample while a stage
+    // glides to a new design (see CascadeEngine::rampStage), 0 otherwise
+    std::array<Register, numStages> b0Step, b1Step, b2Step, a1Step, a2Step;
+
+    BiquadBank()
+    {
+        b0.fill(Register::expand(1.f));
+        b1.fill(Register::expand(0.f));
+        b2.fill(Register::expand(0.f));
+        a1.fill(Register::expand(0.f));
+        a2.fill(Register::expand(0.f));
+
+        clearSteps();
+    }
+
+    void clearStep(int stage)
+    {
+        b0Step[stage] = Register::expand(0.f);
+        b1Step[stage] = Register::expand(0.f);
+        b2Step[stage] = Register::expand(0.f);
+        a1Step[stage] = Register::expand(0.f);
+        a2Step[stage] = Register::expand(0.f);
+    }
+
+    void clearSteps()
+    {
+        for (int stage = 0; stage < numStages; ++stage)
+            clearStep(stage);
+    }
+
+    // moves the coefficients on by numSamples steps once every group went through the ramp
+    void advanceRamp(int numSamples)
+    {
+        auto count = Register::expand(static_cast<typename Register::ElementType>(numSamples));
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            b0[stage] += b0Step[stage] * count;
+            b1[stage] += b1Step[stage] * count;
+            b2[stage] += b2Step[stage] * count;
+            a1[stage] += a1Step[stage] * count;
+            a2[stage] += a2Step[stage] * count;
+        }
+    }
+};
+
+// the two state variables of every stage for one group of channels
+// (as many channels as the register has lanes)
+template<typename Register>
+struct BiquadState
+{
+    std::array<Register, CoefficientSet::numStages> state1, state2;
+
+    BiquadState()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        state1.fill(Register::expand(0.f));
+        state2.fill(Register::expand(0.f));
+    }
+};
+
+// runs every active stage of the bank over the block in one go.
+// it works sample by sample: the input gets gathered into the lanes once,
+// goes through all the active stages and gets scattered back, so the block is
+// read and written a single time no matter how many stages are active.
+// bypassed stages are skipped and their state is left alone which is exactly
+// what the ProcessorChain did with the setBypassed<> flags.
+// with Ramping the coefficients move on by their step after every sample,
+// the bank itself is left alone so every group starts the ramp at the same place
+template<typename Register, bool Ramping = false>
+void processCascade(const BiquadBank<Register>& bank, BiquadState<Register>& state, typename Register::ElementType* const* channels, int numChannels, int numSamples)
+{
+    using SampleType = typename Register::ElementType;
+    constexpr int numLanes = static_cast<int>(Register::SIMDNumElements);
+    jassert(numChannels <= numLanes);
+
+    std::array<int, BiquadBank<Register>::numStages> activeStages;
+    int numActive = 0;
+
+    for (int stage = 0; stage < BiquadBank<Register>::numStages; ++stage)
+    {
+        if (bank.active[stage])
+            activeStages[numActive++] = stage;
+    }
+
+    if (numActive == 0)
+        return;
+
+    auto b0 = bank.b0;
+    auto b1 = bank.b1;
+    auto b2 = bank.b2;
+    auto a1 = bank.a1;
+    auto a2 = bank.a2;
+
+    auto state1 = state.state1;
+    auto state2 = state.state2;
+
+    alignas(sizeof(Register)) SampleType lanes[numLanes] = {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            lanes[ch] = channels[ch][i];
+
+        auto sample = Register::fromRawArray(lanes);
+
+        for (int k = 0; k < numActive; ++k)
+        {
+            auto stage = activeStages[k];
+
+            // transposed direct form II, the same structure juce::dsp::IIR::Filter uses
+            auto output = b0[stage] * sample + state1[stage];
+
+            state1[stage] = b1[stage] * sample - a1[stage] * output + state2[stage];
+            state2[stage] = b2[stage] * sample - a2[stage] * output;
+
+            sample = output;
+
+            if constexpr (Ramping)
+            {
+                b0[stage] += bank.b0Step[stage];
+                b1[stage] += bank.b1Step[stage];
+                b2[stage] += bank.b2Step[stage];
+                a1[stage] += bank.a1Step[stage];
+                a2[stage] += bank.a2Step[stage];
+            }
+        }
+
+        sample.copyToRawArray(lanes);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch][i] = lanes[ch];
+    }
+
+    state.state1 = state1;
+    state.state2 = state2;
+}
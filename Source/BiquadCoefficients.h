@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    BiquadCoefficients.h
+    Created: 16 Oct 2026 9:20:12am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// plain normalised (a0 == 1) coefficients of a single second order section
+// it has the same layout juce uses internally for a 2nd order IIR::Coefficients
+// object (b0, b1, b2, a1, a2) but it lives on the stack and can be copied around
+// without touching the heap
+template<typename NumericType>
+struct BiquadCoefficients
+{
+    NumericType b0{ 1 }, b1{ 0 }, b2{ 0 }, a1{ 0 }, a2{ 0 };
+
+    static BiquadCoefficients fromJuce(const juce::dsp::IIR::Coefficients<NumericType>& source)
+    {
+        jassert(source.getFilterOrder() == 2);
+
+        auto* raw = source.getRawCoefficients();
+        return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+    }
+
+    // writes the values into an already allocated 2nd order coefficients object
+    // the array keeps its size so there is no allocation here
+    void copyTo(juce::dsp::IIR::Coefficients<NumericType>& destination) const
+    {
+        jassert(destination.getFilterOrder() == 2);
+
+        auto* raw = destination.getRawCoefficients();
+        raw[0] = b0;
+        raw[1] = b1;
+        raw[2] = b2;
+        raw[3] = a1;
+        raw[4] = a2;
+    }
+};
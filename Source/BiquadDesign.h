@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    BiquadDesign.h
+    Created: 16 Oct 2026 5:21:09pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include "Slope.h"
+#include "BiquadCoefficients.h"
+
+// filter designers that write straight into BiquadCoefficients.
+// the juce designers hand back ReferenceCountedArray's of heap allocated
+// Coefficients objects, these do the same maths in the same order
+// (so the results are the same) but never touch the heap,
+// which means they are safe to call from the audio thread
+
+//==============================================================
+// a cos that can run at compile time (std::cos can't until c++26)
+// the butterworth angles are all between 0 and pi/2 where the
+// taylor series has converged to double precision long before 24 terms
+constexpr double constexprCos(double x)
+{
+    double term = 1.0;
+    double sum = 1.0;
+
+    for (int i = 1; i < 24; ++i)
+    {
+        term *= -x * x / ((2.0 * i - 1.0) * (2.0 * i));
+        sum += term;
+    }
+
+    return sum;
+}
+
+// the poles of an even order N butterworth sit at the angles (2i + 1) * pi / (2N)
+// and every conjugate pair becomes one 2nd order section with Q = 1 / (2 cos(angle)).
+// this is the Q designIIR*HighOrderButterworthMethod works out every time,
+// here it is done once by the compiler for the 4 slopes (orders 2, 4, 6 and 8)
+template<typename NumericType>
+using BasicButterworthQTable = std::array<std::array<NumericType, 4>, 4>;
+
+using ButterworthQTable = BasicButterworthQTable<float>;
+
+template<typename NumericType>
+constexpr BasicButterworthQTable<NumericType> makeButterworthQTable()
+{
+    BasicButterworthQTable<NumericType> table{};
+
+    for (int slope = 0; slope < 4; ++slope)
+    {
+        auto order = (slope + 1) * 2;
+
+        for (int section = 0; section <= slope; ++section)
+        {
+            auto angle = (2.0 * section + 1.0) * 3.141592653589793 / (order * 2.0);
+            table[slope][section] = static_cast<NumericType>(1.0 / (2.0 * constexprCos(angle)));
+        }
+    }
+
+    return table;
+}
+
+// one table per precision, the double one is for the precise stages of a CoefficientSet
+template<typename NumericType>
+static constexpr BasicButterworthQTable<NumericType> butterworthQTable = makeButterworthQTable<NumericType>();
+
+static constexpr const ButterworthQTable& butterworthQ = butterworthQTable<float>;
+
+// one section for every 12 db/Oct of slope
+constexpr int getNumSections(Slope slope)
+{
+    return static_cast<int>(slope) + 1;
+}
+
+//==============================================================
+// all of these work in float like the juce designers do, or in double
+// for the stages that run in double precision (see CoefficientSet::preciseStages)
+
+// same as juce::dsp::IIR::Coefficients::makeHighPass
+template<typename NumericType>
+BiquadCoefficients<NumericType> designHighPassSection(NumericType frequency, double sampleRate, NumericType Q)
+{
+    auto n = std::tan(juce::MathConstants<NumericType>::pi * frequency / static_cast<NumericType>(sampleRate));
+    auto nSquared = n * n;
+    auto invQ = 1 / Q;
+    auto c1 = 1 / (1 + invQ * n + nSquared);
+
+    return { c1, c1 * -2, c1, c1 * 2 * (nSquared - 1), c1 * (1 - invQ * n + nSquared) };
+}
+
+// same as juce::dsp::IIR::Coefficients::makeLowPass
+template<typename NumericType>
+BiquadCoefficients<NumericType> designLowPassSection(NumericType frequency, double sampleRate, NumericType Q)
+{
+    auto n = 1 / std::tan(juce::MathConstants<NumericType>::pi * frequency / static_cast<NumericType>(sampleRate));
+    auto nSquared = n * n;
+    auto invQ = 1 / Q;
+    auto c1 = 1 / (1 + invQ * n + nSquared);
+
+    return { c1, c1 * 2, c1, c1 * 2 * (1 - nSquared), c1 * (1 - invQ * n + nSquared) };
+}
+
+// the replacements for makeLowCutFilter and makeHighCutFilter
+// they fill the first getNumSections(slope) entries and return how many that was.
+// the precision is the one of the sections they write into
+template<typename SectionArray>
+int designLowCutSections(SectionArray& sections, float frequency, double sampleRate, Slope slope)
+{
+    using NumericType = decltype(sections[0].b0);
+
+    auto numSections = getNumSections(slope);
+
+    for (int i = 0; i < numSections; ++i)
+        sections[i] = designHighPassSection(static_cast<NumericType>(frequency), sampleRate, butterworthQTable<NumericType>[slope][i]);
+
+    return numSections;
+}
+
+template<typename SectionArray>
+int designHighCutSections(SectionArray& sections, float frequency, double sampleRate, Slope slope)
+{
+    using NumericType = decltype(sections[0].b0);
+
+    auto numSections = getNumSections(slope);
+
+    for (int i = 0; i < numSections; ++i)
+        sections[i] = designLowPassSection(static_cast<NumericType>(frequency), sampleRate, butterworthQTable<NumericType>[slope][i]);
+
+    return numSections;
+}
+
+// same as juce::dsp::IIR::Coefficients::makePeakFilter with the gain in decibels
+template<typename NumericType>
+BiquadCoefficients<NumericType> designPeakSection(NumericType frequency, NumericType Q, NumericType gainInDecibells, double sampleRate)
+{
+    auto gainFactor = juce::Decibels::decibelsToGain(gainInDecibells);
+
+    auto A = juce::jmax(NumericType(0), std::sqrt(gainFactor));
+    auto omega = (2 * juce::MathConstants<NumericType>::pi * juce::jmax(frequency, NumericType(2))) / static_cast<NumericType>(sampleRate);
+    auto alpha = std::sin(omega) / (Q * 2);
+    auto c2 = -2 * std::cos(omega);
+    auto alphaTimesA = alpha * A;
+    auto alphaOverA = alpha / A;
+
+    // the juce Coefficients constructor normalises by a0 like this
+    auto a0Inverse = 1 / (1 + alphaOverA);
+
+    return { (1 + alphaTimesA) * a0Inverse, c2 * a0Inverse, (1 - alphaTimesA) * a0Inverse,
+             c2 * a0Inverse, (1 - alphaOverA) * a0Inverse };
+}
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    BlockLoadMeter.h
+    Created: 17 Oct 2026 12:21:47am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cmath>
+
+// how long every processBlock took against the time the block lasts
+// (numSamples / sampleRate), so a load of 1 is a block that only just made it.
+// the audio thread is the only writer and only ever loads and stores its own
+// counters, the message thread (or a headless host) reads them whenever it likes.
+// nobody waits and nothing gets allocated, the counters start over in prepare()
+struct BlockLoadMeter
+{
+    // the loads go into buckets 1/8 of an octave wide from 2^-14 (0.006%)
+    // up to 2^4 (1600%), whatever is outside ends up in the first or the last one
+    static constexpr int bucketsPerOctave = 8;
+    static constexpr int lowestOctave = -14;
+    static constexpr int numOctaves = 18;
+    static constexpr int numBuckets = bucketsPerOctave * numOctaves;
+
+    // the first bucket that starts at a load of 1
+    static constexpr int overBudgetBucket = -lowestOctave * bucketsPerOctave;
+
+    struct Statistics
+    {
+        juce::uint64 numBlocks = 0;
+        juce::uint64 numOverBudget = 0;
+
+        // the upper edge of the bucket the percentile falls into
+        double p50 = 0.0;
+        double p99 = 0.0;
+        // the real worst block, not a bucket
+        double max = 0.0;
+    };
+
+    //==============================================================
+    // not while processBlock could be running, prepareToPlay is fine
+    void prepare(double sampleRate)
+    {
+        ticksPerSample = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / sampleRate;
+
+        for (auto& bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+
+        maxLoad.store(0.0, std::memory_order_relaxed);
+    }
+
+    //==============================================================
+    // audio thread
+    void addBlock(juce::int64 elapsedTicks, int numSamples)
+    {
+        if (numSamples <= 0 || ticksPerSample <= 0.0)
+            return;
+
+        auto load = static_cast<double>(elapsedTicks) / (ticksPerSample * numSamples);
+
+        auto& bucket = buckets[static_cast<size_t>(getBucketFor(load))];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (load > maxLoad.load(std::memory_order_relaxed))
+            maxLoad.store(load, std::memory_order_relaxed);
+    }
+
+    // times everything from here to the end of the scope
+    struct ScopedBlockTimer
+    {
+        ScopedBlockTimer(BlockLoadMeter& meterToUse, int numSamplesInBlock)
+            : meter(meterToUse), numSamples(numSamplesInBlock), start(juce::Time::getHighResolutionTicks()) { }
+
+        ~ScopedBlockTimer()
+        {
+            meter.addBlock(juce::Time::getHighResolutionTicks() - start, numSamples);
+        }
+
+        BlockLoadMeter& meter;
+        int numSamples;
+        juce::int64 start;
+    };
+
+    //==============================================================
+    // any thread
+    // a block that comes in while this is reading may or may not be counted yet
+    Statistics getStatistics() const
+    {
+        std::array<juce::uint64, numBuckets> counts;
+        Statistics statistics;
+
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            counts[static_cast<size_t>(i)] = buckets[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+            statistics.numBlocks += counts[static_cast<size_t>(i)];
+
+            if (i >= overBudgetBucket)
+                statistics.numOverBudget += counts[static_cast<size_t>(i)];
+        }
+
+        statistics.p50 = getPercentile(counts, statistics.numBlocks, 0.5);
+        statistics.p99 = getPercentile(counts, statistics.numBlocks, 0.99);
+        statistics.max = maxLoad.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    static double getBucketUpperEdge(int bucket)
+    {
+        return std::exp2(lowestOctave + static_cast<double>(bucket + 1) / bucketsPerOctave);
+    }
+
+private:
+    static int getBucketFor(double load)
+    {
+        if (!(load > 0.0))
+            return 0;
+
+        auto bucket = static_cast<int>(std::floor((std::log2(load) - lowestOctave) * bucketsPerOctave));
+        return juce::jlimit(0, numBuckets - 1, bucket);
+    }
+
+    static double getPercentile(const std::array<juce::uint64, numBuckets>& counts, juce::uint64 numBlocks, double percentile)
+    {
+        if (numBlocks == 0)
+            return 0.0;
+
+        auto rank = static_cast<juce::uint64>(std::ceil(percentile * static_cast<double>(numBlocks)));
+        juce::uint64 seen = 0;
+
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            seen += counts[static_cast<size_t>(i)];
+
+            if (seen >= rank)
+                return getBucketUpperEdge(i);
+        }
+
+        return getBucketUpperEdge(numBuckets - 1);
+    }
+
+    double ticksPerSample = 0.0;
+
+    std::array<std::atomic<juce::uint32>, numBuckets> buckets{};
+    std::atomic<double> maxLoad{ 0.0 };
+};
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    CascadeEngine.h
+    Created: 16 Oct 2026 11:05:37am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "CascadeKernels.h"
+
+// runs the whole 9 stage cascade for any number of channels.
+// the channels are packed into the lanes of a SIMDRegister, one group of
+// lanes at a time, so every biquad processes a whole group with the same
+// instructions instead of running a MonoChain per channel.
+// stereo is a single (half full) group, 7.1.4 is 3 groups with sse.
+// all the groups share one set of coefficients, only the filter state is per group.
+// the loop that runs is picked from CascadeKernels whenever the active stages
+// change, so a 12 db/Oct low cut on its own really only runs 1 biquad.
+// stages can also glide to new coefficients over a number of samples,
+// that's what the smoothed automation uses (see rampStage).
+// it runs in float or in double, the double one uses the preciseStages of the sets
+template<typename SampleType>
+struct BasicCascadeEngine
+{
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+    using Coefficients = BiquadCoefficients<SampleType>;
+
+    static constexpr int numLanes = static_cast<int>(Register::SIMDNumElements);
+
+    // enough for 7th order ambisonics (64 channels)
+    static constexpr int maxChannels = 64;
+    static constexpr int maxGroups = (maxChannels + numLanes - 1) / numLanes;
+
+    void reset()
+    {
+        finishRamp();
+
+        for (auto& state : states)
+            state.reset();
+    }
+
+    // the same coefficients for every lane
+    // this also stops the stage if it was in the middle of a ramp
+    void setStage(int index, const Coefficients& coefficients, bool active)
+    {
+        if (ramping[index])
+        {
+            ramping[index] = false;
+            bank.clearStep(index);
+        }
+
+        bank.b0[index] = Register::expand(coefficients.b0);
+        bank.b1[index] = Register::expand(coefficients.b1);
+        bank.b2[index] = Register::expand(coefficients.b2);
+        bank.a1[index] = Register::expand(coefficients.a1);
+        bank.a2[index] = Register::expand(coefficients.a2);
+
+        if (bank.active[index] != active)
+        {
+            bank.active[index] = active;
+            kernel = nullptr;
+        }
+    }
+
+    // glides an active stage from its current coefficients to the target over
+    // numSamples by adding a fixed step to every coefficient after each sample.
+    // a straight line between two stable biquads stays stable (the a1/a2
+    // stability triangle is convex) so the filter can't blow up halfway.
+    // all the stages that ramp at the same time have to use the same length
+    void rampStage(int index, const Coefficients& target, int numSamples)
+    {
+        jassert(bank.active[index] && numSamples > 0);
+
+        // a ramp of another length is still running, land it first
+        if (rampSamplesRemaining > 0 && rampSamplesRemaining != numSamples)
+            finishRamp();
+
+        auto scale = Register::expand(SampleType(1) / static_cast<SampleType>(numSamples));
+
+        bank.b0Step[index] = (Register::expand(target.b0) - bank.b0[index]) * scale;
+        bank.b1Step[index] = (Register::expand(target.b1) - bank.b1[index]) * scale;
+        bank.b2Step[index] = (Register::expand(target.b2) - bank.b2[index]) * scale;
+        bank.a1Step[index] = (Register::expand(target.a1) - bank.a1[index]) * scale;
+        bank.a2Step[index] = (Register::expand(target.a2) - bank.a2[index]) * scale;
+
+        rampTargets[index] = target;
+        ramping[index] = true;
+        rampSamplesRemaining = numSamples;
+    }
+
+    // copies all the stages of one band (LowCut, Peak or HighCut) from the set.
+    // with enabled == false the band's stages are switched off in this engine
+    // (another engine runs them, see the mixed precision in the processor)
+    void setBand(const CoefficientSet& set, ChainPossitions band, bool enabled = true)
+    {
+        const auto& stages = set.getStages<SampleType>();
+
+        forEachStage(band, [this, &set, &stages, enabled](int stage)
+        {
+            setStage(stage, stages[stage], enabled && set.active[stage]);
+        });
+    }
+
+    // like setBand but the stages that stay active glide to the new
+    // coefficients over numSamples instead of jumping
+    void rampBand(const CoefficientSet& set, ChainPossitions band, int numSamples, bool enabled = true)
+    {
+        const auto& stages = set.getStages<SampleType>();
+
+        forEachStage(band, [this, &set, &stages, numSamples, enabled](int stage)
+        {
+            if (enabled && set.active[stage] && bank.active[stage])
+                rampStage(stage, stages[stage], numSamples);
+            else
+                setStage(stage, stages[stage], enabled && set.active[stage]);
+        });
+    }
+
+    bool hasActiveStages() const
+    {
+        for (auto active : bank.active)
+        {
+            if (active)
+                return true;
+        }
+
+        return false;
+    }
+
+    void process(SampleType* const* channels, int numChannels, int numSamples)
+    {
+        jassert(numChannels <= maxChannels);
+        numChannels = juce::jmin(numChannels, maxChannels);
+
+        if (kernel == nullptr)
+        {
+            kernel = CascadeKernels::selectKernel<Register>(bank);
+            rampKernel = CascadeKernels::selectKernel<Register, true>(bank);
+        }
+
+        // the part of the block that is still inside a ramp
+        if (rampSamplesRemaining > 0)
+        {
+            auto numRampSamples = juce::jmin(numSamples, rampSamplesRemaining);
+
+            processGroups(rampKernel, channels, numChannels, 0, numRampSamples);
+            bank.advanceRamp(numRampSamples);
+
+            rampSamplesRemaining -= numRampSamples;
+
+            if (rampSamplesRemaining == 0)
+                finishRamp();
+
+            if (numRampSamples < numSamples)
+                processGroups(kernel, channels, numChannels, numRampSamples, numSamples - numRampSamples);
+
+            return;
+        }
+
+        processGroups(kernel, channels, numChannels, 0, numSamples);
+    }
+
+private:
+    BiquadBank<Register> bank;
+    std::array<BiquadState<Register>, maxGroups> states;
+
+    // the specialised loops for the current active stages
+    // set back to nullptr whenever a stage gets switched on or off
+    CascadeKernel<Register> kernel = nullptr;
+    CascadeKernel<Register> rampKernel = nullptr;
+
+    // where the ramping stages end up, so they land exactly on the
+    // design instead of wherever adding up the steps got them
+    std::array<Coefficients, CoefficientSet::numStages> rampTargets;
+    std::array<bool, CoefficientSet::numStages> ramping{};
+    int rampSamplesRemaining = 0;
+
+    void finishRamp()
+    {
+        for (int stage = 0; stage < CoefficientSet::numStages; ++stage)
+        {
+            if (ramping[stage])
+                setStage(stage, rampTargets[stage], bank.active[stage]);
+        }
+
+        rampSamplesRemaining = 0;
+    }
+
+    // runs the kernel over every group of numLanes channels, starting at startSample
+    void processGroups(CascadeKernel<Register> kernelToUse, SampleType* const* channels, int numChannels, int startSample, int numSamples)
+    {
+        std::array<SampleType*, numLanes> groupChannels;
+
+        for (int group = 0; group * numLanes < numChannels; ++group)
+        {
+            auto firstChannel = group * numLanes;
+            auto numGroupChannels = juce::jmin(numLanes, numChannels - firstChannel);
+
+            for (int lane = 0; lane < numGroupChannels; ++lane)
+                groupChannels[lane] = channels[firstChannel + lane] + startSample;
+
+            kernelToUse(bank, states[group], groupChannels.data(), numGroupChannels, numSamples);
+        }
+    }
+
+    template<typename Function>
+    static void forEachStage(ChainPossitions band, Function&& function)
+    {
+        switch (band)
+        {
+        case LowCut:
+            for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+                function(CoefficientSet::lowCutStage(i));
+            break;
+        case Peak:
+            function(CoefficientSet::peakStage);
+            break;
+        case HighCut:
+            for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+                function(CoefficientSet::highCutStage(i));
+            break;
+        }
+    }
+};
+
+using CascadeEngine = BasicCascadeEngine<float>;
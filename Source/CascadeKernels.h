@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    CascadeKernels.h
+    Created: 16 Oct 2026 2:02:51pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <utility>
+#include "BiquadBank.h"
+
+// a kernel is a version of processCascade that was compiled for one exact
+// combination of active stages, so the hot loop has no bypass checks at all.
+// the slope of a cut band only decides how many of its 4 sections run
+// (always the first ones) and a bypassed band simply runs 0 sections, so
+// 5 (low cut) x 2 (peak) x 5 (high cut) = 50 kernels cover every setting.
+// every kernel also comes in a ramping version that glides the coefficients
+// by their per sample step, that one only runs while automation is smoothed
+template<typename Register>
+using CascadeKernel = void(*)(const BiquadBank<Register>&, BiquadState<Register>&, typename Register::ElementType* const*, int, int);
+
+namespace CascadeKernels
+{
+    static constexpr int numCutOptions = CoefficientSet::numCutStages + 1;
+    static constexpr int numKernels = numCutOptions * 2 * numCutOptions;
+
+    constexpr int getKernelIndex(int numLowCut, bool usePeak, int numHighCut)
+    {
+        return (numLowCut * 2 + (usePeak ? 1 : 0)) * numCutOptions + numHighCut;
+    }
+
+    //==============================================================
+    // builds the list of stage indices a kernel runs at compile time
+    template<int Offset, int... Indices>
+    constexpr auto offsetSequence(std::integer_sequence<int, Indices...>)
+    {
+        return std::integer_sequence<int, (Offset + Indices)...>{};
+    }
+
+    template<int... A, int... B, int... C>
+    constexpr auto joinSequences(std::integer_sequence<int, A...>, std::integer_sequence<int, B...>, std::integer_sequence<int, C...>)
+    {
+        return std::integer_sequence<int, A..., B..., C...>{};
+    }
+
+    template<int NumLowCut, bool UsePeak, int NumHighCut>
+    using StageSequence = decltype(joinSequences(
+        offsetSequence<CoefficientSet::lowCutStage(0)>(std::make_integer_sequence<int, NumLowCut>{}),
+        offsetSequence<CoefficientSet::peakStage>(std::make_integer_sequence<int, UsePeak ? 1 : 0>{}),
+        offsetSequence<CoefficientSet::highCutStage(0)>(std::make_integer_sequence<int, NumHighCut>{})));
+
+    //==============================================================
+    template<typename Register, bool Ramping, int... Stages>
+    void runStages(const BiquadBank<Register>& bank, BiquadState<Register>& state, typename Register::ElementType* const* channels, int numChannels, int numSamples, std::integer_sequence<int, Stages...>)
+    {
+        constexpr int numActive = static_cast<int>(sizeof...(Stages));
+
+        if constexpr (numActive == 0)
+        {
+            juce::ignoreUnused(bank, state, channels, numChannels, numSamples);
+        }
+        else
+        {
+            constexpr int numLanes = static_cast<int>(Register::SIMDNumElements);
+            constexpr std::array<int, numActive> stages{ Stages... };
+
+            // everything the loop needs lives in locals, the trip counts below
+            // are compile time constants so the compiler unrolls them and can
+            // keep the coefficients and the state in registers
+            std::array<Register, numActive> b0, b1, b2, a1, a2, state1, state2;
+            std::array<Register, numActive> b0Step, b1Step, b2Step, a1Step, a2Step;
+
+            for (int k = 0; k < numActive; ++k)
+            {
+                b0[k] = bank.b0[stages[k]];
+                b1[k] = bank.b1[stages[k]];
+                b2[k] = bank.b2[stages[k]];
+                a1[k] = bank.a1[stages[k]];
+                a2[k] = bank.a2[stages[k]];
+                state1[k] = state.state1[stages[k]];
+                state2[k] = state.state2[stages[k]];
+
+                if constexpr (Ramping)
+                {
+                    b0Step[k] = bank.b0Step[stages[k]];
+                    b1Step[k] = bank.b1Step[stages[k]];
+                    b2Step[k] = bank.b2Step[stages[k]];
+                    a1Step[k] = bank.a1Step[stages[k]];
+                    a2Step[k] = bank.a2Step[stages[k]];
+                }
+            }
+
+            alignas(sizeof(Register)) typename Register::ElementType lanes[numLanes] = {};
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    lanes[ch] = channels[ch][i];
+
+                auto sample = Register::fromRawArray(lanes);
+
+                for (int k = 0; k < numActive; ++k)
+                {
+                    // transposed direct form II, the same structure juce::dsp::IIR::Filter uses
+                    auto output = b0[k] * sample + state1[k];
+
+                    state1[k] = b1[k] * sample - a1[k] * output + state2[k];
+                    state2[k] = b2[k] * sample - a2[k] * output;
+
+                    sample = output;
+
+                    if constexpr (Ramping)
+                    {
+                        b0[k] += b0Step[k];
+                        b1[k] += b1Step[k];
+                        b2[k] += b2Step[k];
+                        a1[k] += a1Step[k];
+                        a2[k] += a2Step[k];
+                    }
+                }
+
+                sample.copyToRawArray(lanes);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    channels[ch][i] = lanes[ch];
+            }
+
+            for (int k = 0; k < numActive; ++k)
+            {
+                state.state1[stages[k]] = state1[k];
+                state.state2[stages[k]] = state2[k];
+            }
+        }
+    }
+
+    template<typename Register, bool Ramping, int NumLowCut, bool UsePeak, int NumHighCut>
+    void processKernel(const BiquadBank<Register>& bank, BiquadState<Register>& state, typename Register::ElementType* const* channels, int numChannels, int numSamples)
+    {
+        runStages<Register, Ramping>(bank, state, channels, numChannels, numSamples, StageSequence<NumLowCut, UsePeak, NumHighCut>{});
+    }
+
+    //==============================================================
+    template<typename Register, bool Ramping, int Index>
+    constexpr CascadeKernel<Register> makeKernel()
+    {
+        constexpr int numLowCut = Index / (2 * numCutOptions);
+        constexpr bool usePeak = (Index / numCutOptions) % 2 == 1;
+        constexpr int numHighCut = Index % numCutOptions;
+
+        static_assert(getKernelIndex(numLowCut, usePeak, numHighCut) == Index, "kernel table is out of order");
+
+        return &processKernel<Register, Ramping, numLowCut, usePeak, numHighCut>;
+    }
+
+    template<typename Register, bool Ramping, int... Indices>
+    constexpr std::array<CascadeKernel<Register>, numKernels> makeKernelTable(std::integer_sequence<int, Indices...>)
+    {
+        return { makeKernel<Register, Ramping, Indices>()... };
+    }
+
+    // the dispatch tables, built once at compile time
+    template<typename Register, bool Ramping>
+    const std::array<CascadeKernel<Register>, numKernels>& getKernelTable()
+    {
+        static constexpr auto table = makeKernelTable<Register, Ramping>(std::make_integer_sequence<int, numKernels>{});
+        return table;
+    }
+
+    // counts how many sections of a cut band are active, or returns -1
+    // if they are not the first N in a row (the kernels can't express that)
+    template<typename Register>
+    int countLeadingActiveStages(const BiquadBank<Register>& bank, int firstStage)
+    {
+        int count = 0;
+
+        while (count < CoefficientSet::numCutStages && bank.active[firstStage + count])
+            ++count;
+
+        for (int i = count; i < CoefficientSet::numCutStages; ++i)
+        {
+            if (bank.active[firstStage + i])
+                return -1;
+        }
+
+        return count;
+    }
+
+    // picks the specialised kernel for the bank's active stages
+    // only needs calling when the stages change, not for every block
+    template<typename Register, bool Ramping = false>
+    CascadeKernel<Register> selectKernel(const BiquadBank<Register>& bank)
+    {
+        auto numLowCut = countLeadingActiveStages(bank, CoefficientSet::lowCutStage(0));
+        auto numHighCut = countLeadingActiveStages(bank, CoefficientSet::highCutStage(0));
+
+        // stages that were switched on one by one with setStage() can end up in a
+        // pattern no kernel covers, the generic loop handles any combination
+        if (numLowCut < 0 || numHighCut < 0)
+            return &processCascade<Register, Ramping>;
+
+        return getKernelTable<Register, Ramping>()[getKernelIndex(numLowCut, bank.active[CoefficientSet::peakStage], numHighCut)];
+    }
+}
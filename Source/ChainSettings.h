@@ -9,6 +9,7 @@
 */
 
 #pragma once
+#include "Slope.h"
 // struct that contains the filter parameters
 struct ChainSettings
 {
@@ -20,4 +21,38 @@ struct ChainSettings
 
     bool lowCutBypassed{ false }, peakBypassed{ false }, highCutBypassed{ false }/*, analyserEnabled{ true }*/;
 
-};
\ No newline at end of file
+};
+
+// true when the settings can't be heard: every band is either bypassed
+// or sitting at the end of its range (20 Hz low cut, 0 dB peak, 20 kHz high cut)
+// which is exactly what the default parameters are
+inline bool isAudiblyTransparent(const ChainSettings& chainSettings)
+{
+    auto lowCutTransparent = chainSettings.lowCutBypassed || chainSettings.lowCutFreq <= 20.f;
+    auto peakTransparent = chainSettings.peakBypassed || std::abs(chainSettings.peakGainInDecibells) < 0.05f;
+    auto highCutTransparent = chainSettings.highCutBypassed || chainSettings.highCutFreq >= 20000.f;
+
+    return lowCutTransparent && peakTransparent && highCutTransparent;
+}
+
+// the raw parameter values are looked up by their id once and then cached
+// so reading them later doesn't need any string comparisons
+struct ChainParameters
+{
+    ChainParameters(juce::AudioProcessorValueTreeState& apvts);
+
+    std::atomic<float>* lowCutFreq;
+    std::atomic<float>* highCutFreq;
+    std::atomic<float>* peakFreq;
+    std::atomic<float>* peakGainInDecibells;
+    std::atomic<float>* peakQ;
+    std::atomic<float>* lowCutSlope;
+    std::atomic<float>* highCutSlope;
+    std::atomic<float>* lowCutBypassed;
+    std::atomic<float>* peakBypassed;
+    std::atomic<float>* highCutBypassed;
+};
+
+// function that return the parameters in a ChainSettings struct
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+ChainSettings getChainSettings(const ChainParameters& parameters);
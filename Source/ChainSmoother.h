@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    ChainSmoother.h
+    Created: 16 Oct 2026 3:12:40pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "CoefficientSet.h"
+
+// ramps the continuous ChainSettings fields (frequencies, gain and Q)
+// from where they are to the latest published values.
+// the processor moves the ramps on at a fixed control rate and designs
+// the filters from getCurrentSettings() every time, so an automated
+// knob glides instead of jumping once per host block.
+// the slopes and the bypass switches can't glide, a band whose slope or
+// bypass changed jumps straight to its new settings like before
+struct ChainSmoother
+{
+    using BandFlags = std::array<bool, CoefficientSet::numBands>;
+
+    void prepare(double sampleRate, double rampLengthSeconds)
+    {
+        lowCutFreq.reset(sampleRate, rampLengthSeconds);
+        highCutFreq.reset(sampleRate, rampLengthSeconds);
+        peakFreq.reset(sampleRate, rampLengthSeconds);
+        peakGainInDecibells.reset(sampleRate, rampLengthSeconds);
+        peakQ.reset(sampleRate, rampLengthSeconds);
+    }
+
+    // a band can only glide if it is playing and keeps its slope
+    bool canGlideTo(const ChainSettings& target, ChainPossitions band) const
+    {
+        switch (band)
+        {
+        case LowCut:
+            return !current.lowCutBypassed && !target.lowCutBypassed && current.lowCutSlope == target.lowCutSlope;
+        case Peak:
+            return !current.peakBypassed && !target.peakBypassed;
+        case HighCut:
+            return !current.highCutBypassed && !target.highCutBypassed && current.highCutSlope == target.highCutSlope;
+        }
+
+        return false;
+    }
+
+    void setTarget(const ChainSettings& target, ChainPossitions band)
+    {
+        switch (band)
+        {
+        case LowCut:
+            lowCutFreq.setTargetValue(target.lowCutFreq);
+            break;
+        case Peak:
+            peakFreq.setTargetValue(target.peakFreq);
+            peakGainInDecibells.setTargetValue(target.peakGainInDecibells);
+            peakQ.setTargetValue(target.peakQ);
+            break;
+        case HighCut:
+            highCutFreq.setTargetValue(target.highCutFreq);
+            break;
+        }
+    }
+
+    void jumpTo(const ChainSettings& target, ChainPossitions band)
+    {
+        switch (band)
+        {
+        case LowCut:
+            lowCutFreq.setCurrentAndTargetValue(target.lowCutFreq);
+            current.lowCutFreq = target.lowCutFreq;
+            current.lowCutSlope = target.lowCutSlope;
+            current.lowCutBypassed = target.lowCutBypassed;
+            break;
+        case Peak:
+            peakFreq.setCurrentAndTargetValue(target.peakFreq);
+            peakGainInDecibells.setCurrentAndTargetValue(target.peakGainInDecibells);
+            peakQ.setCurrentAndTargetValue(target.peakQ);
+            current.peakFreq = target.peakFreq;
+            current.peakGainInDecibells = target.peakGainInDecibells;
+            current.peakQ = target.peakQ;
+            current.peakBypassed = target.peakBypassed;
+            break;
+        case HighCut:
+            highCutFreq.setCurrentAndTargetValue(target.highCutFreq);
+            current.highCutFreq = target.highCutFreq;
+            current.highCutSlope = target.highCutSlope;
+            current.highCutBypassed = target.highCutBypassed;
+            break;
+        }
+    }
+
+    void jumpTo(const ChainSettings& target)
+    {
+        jumpTo(target, LowCut);
+        jumpTo(target, Peak);
+        jumpTo(target, HighCut);
+    }
+
+    bool isSmoothing(ChainPossitions band) const
+    {
+        switch (band)
+        {
+        case LowCut:
+            return lowCutFreq.isSmoothing();
+        case Peak:
+            return peakFreq.isSmoothing() || peakGainInDecibells.isSmoothing() || peakQ.isSmoothing();
+        case HighCut:
+            return highCutFreq.isSmoothing();
+        }
+
+        return false;
+    }
+
+    // moves every ramp on by numSamples and returns the bands that moved.
+    // a band that reaches its target here still counts as moved,
+    // it needs one last design to land exactly on it
+    BandFlags advance(int numSamples)
+    {
+        BandFlags moved{};
+
+        moved[LowCut] = isSmoothing(LowCut);
+        moved[Peak] = isSmoothing(Peak);
+        moved[HighCut] = isSmoothing(HighCut);
+
+        if (moved[LowCut])
+            current.lowCutFreq = lowCutFreq.skip(numSamples);
+
+        if (moved[Peak])
+        {
+            current.peakFreq = peakFreq.skip(numSamples);
+            current.peakGainInDecibells = peakGainInDecibells.skip(numSamples);
+            current.peakQ = peakQ.skip(numSamples);
+        }
+
+        if (moved[HighCut])
+            current.highCutFreq = highCutFreq.skip(numSamples);
+
+        return moved;
+    }
+
+    // the settings the bands are at right now
+    const ChainSettings& getCurrentSettings() const { return current; }
+
+private:
+    // frequencies and Q are heard logarithmically so they ramp multiplicatively
+    // the gain is already in decibels so a straight line is fine
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> lowCutFreq, highCutFreq, peakFreq, peakQ;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> peakGainInDecibells;
+
+    ChainSettings current;
+};
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+    CoefficientService.h
+    Created: 16 Oct 2026 9:58:51am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "CoefficientSet.h"
+#include "TripleBuffer.h"
+
+// one background thread that is shared by every plugin instance
+// designing a filter is cheap enough that a single thread can
+// keep up with a lot of instances
+struct CoefficientDesignThread : juce::TimeSliceThread
+{
+    CoefficientDesignThread() : juce::TimeSliceThread("SimpleEQ Coefficient Designer")
+    {
+        startThread();
+    }
+};
+
+// designs the filter coefficients away from the audio thread whenever a
+// parameter changes and publishes the complete set through a TripleBuffer.
+// the audio thread only has to pull the latest set and copy the values over
+//
+// every band has its own version counter which the parameter listener bumps
+// only the bands whose version moved get redesigned and the published set
+// carries the versions so the audio thread can skip the unchanged bands too
+struct CoefficientService : private juce::TimeSliceClient
+    , private juce::AudioProcessorValueTreeState::Listener
+{
+    CoefficientService(juce::AudioProcessorValueTreeState& state) :
+        apvts(state),
+        parameters(state)
+    {
+        for (auto* id : getParameterIDs())
+            apvts.addParameterListener(id, this);
+
+        designThread->addTimeSliceClient(this);
+    }
+
+    ~CoefficientService()
+    {
+        // this waits until the designer is not using us anymore
+        designThread->removeTimeSliceClient(this);
+
+        for (auto* id : getParameterIDs())
+            apvts.removeParameterListener(id, this);
+    }
+
+    // called from prepareToPlay, designs straight away
+    // so the first block already has the right coefficients
+    void prepare(double newSampleRate)
+    {
+        sampleRate.store(newSampleRate);
+        designNow();
+    }
+
+    // redesigns every band and publishes synchronously
+    // don't call this from the audio thread
+    void designNow()
+    {
+        for (auto& version : bandVersions)
+            version.fetch_add(1);
+
+        designAndPublish();
+    }
+
+    // goes up by one every time a new set gets published
+    juce::uint32 getNumDesigns() const
+    {
+        return numDesigns.load();
+    }
+
+    // a copy of the last published set, for other designers that build on it
+    // don't call this from the audio thread
+    void copyLatestDesign(CoefficientSet& destination)
+    {
+        const juce::ScopedLock sl(writerLock);
+        destination = designedSet;
+    }
+
+    // the tail of the last published set, for getTailLengthSeconds()
+    double getTailLengthSeconds() const
+    {
+        return tailLengthSeconds.load();
+    }
+
+    // audio thread only
+    // returns the newest set or nullptr if nothing changed since the last call
+    const CoefficientSet* pullLatest()
+    {
+        return publishedSets.pull() ? &publishedSets.getReadBuffer() : nullptr;
+    }
+
+private:
+    juce::AudioProcessorValueTreeState& apvts;
+    juce::SharedResourcePointer<CoefficientDesignThread> designThread;
+
+    TripleBuffer<CoefficientSet> publishedSets;
+
+    // the designer thread and prepare/setStateInformation can both publish
+    // so the writer side of the triple buffer is protected by this lock
+    // the audio thread never touches it
+    juce::CriticalSection writerLock;
+
+    ChainParameters parameters;
+
+    std::atomic<double> sampleRate{ 0.0 };
+    std::atomic<double> tailLengthSeconds{ 0.0 };
+    std::atomic<juce::uint32> numDesigns{ 0 };
+
+    // bumped by the listener, one counter per band
+    std::array<std::atomic<juce::uint32>, CoefficientSet::numBands> bandVersions{};
+
+    // only touched while holding the writerLock
+    // this is the set we keep up to date band by band and copy into the triple buffer
+    CoefficientSet designedSet;
+    std::array<juce::uint32, CoefficientSet::numBands> designedVersions{};
+
+    static constexpr int pollIntervalMs = 2;
+
+    static const std::array<const char*, 10>& getParameterIDs()
+    {
+        static const std::array<const char*, 10> ids
+        {
+            "LowCut Freq", "LowCut Slope", "LowCut Bypassed",
+            "Peak Freq", "Peak Gain", "Peak Q", "Peak Bypassed",
+            "HighCut Freq", "HighCut Slope", "HighCut Bypassed"
+        };
+
+        return ids;
+    }
+
+    static ChainPossitions getBandForParameter(const juce::String& parameterID)
+    {
+        if (parameterID.startsWith("LowCut"))
+            return LowCut;
+
+        if (parameterID.startsWith("Peak"))
+            return Peak;
+
+        return HighCut;
+    }
+
+    void parameterChanged(const juce::String& parameterID, float newValue) override
+    {
+        juce::ignoreUnused(newValue);
+
+        // this can be called from any thread (even the audio thread)
+        // so all we do is move the band's version on for the designer
+        bandVersions[getBandForParameter(parameterID)].fetch_add(1);
+    }
+
+    int useTimeSlice() override
+    {
+        designAndPublish();
+
+        return pollIntervalMs;
+    }
+
+    void designAndPublish()
+    {
+        const juce::ScopedLock sl(writerLock);
+
+        auto currentSampleRate = sampleRate.load();
+
+        // nothing to design for until prepareToPlay gave us a sample rate
+        if (currentSampleRate <= 0.0)
+            return;
+
+        // read the versions before the parameters, if a parameter changes
+        // after this we will see the newer version on the next time slice
+        std::array<juce::uint32, CoefficientSet::numBands> versions;
+
+        for (int band = 0; band < CoefficientSet::numBands; ++band)
+            versions[band] = bandVersions[band].load();
+
+        if (versions == designedVersions)
+            return;
+
+        auto chainSettings = getChainSettings(parameters);
+
+        for (int band = 0; band < CoefficientSet::numBands; ++band)
+        {
+            if (versions[band] == designedVersions[band])
+                continue;
+
+            designBand(designedSet, static_cast<ChainPossitions>(band), chainSettings, currentSampleRate);
+            designPreciseBand(designedSet, static_cast<ChainPossitions>(band), chainSettings, currentSampleRate);
+            designedSet.versions[band] = versions[band];
+            designedVersions[band] = versions[band];
+        }
+
+        // working out the tail needs a few logs, that's done here
+        // so the audio thread only has to read the numbers
+        designedSet.tailSamples = computeTailSamples(designedSet);
+        designedSet.neutral = isAudiblyTransparent(designedSet.settings);
+        tailLengthSeconds.store(designedSet.tailSamples / currentSampleRate);
+
+        publishedSets.getWriteBuffer() = designedSet;
+        publishedSets.publish();
+
+        numDesigns.fetch_add(1);
+    }
+};
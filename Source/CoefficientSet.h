@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    CoefficientSet.h
+    Created: 16 Oct 2026 9:40:27am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <limits>
+#include <type_traits>
+#include "ChainPossitions.h"
+#include "FilterDesign.h"
+#include "BiquadDesign.h"
+
+// a complete, immutable snapshot of every biquad in the chain
+// the stages are laid out the same way as in the MonoChain:
+// 4 low cut sections, the peak filter and then 4 high cut sections
+struct CoefficientSet
+{
+    static constexpr int numCutStages = 4;
+    static constexpr int numStages = numCutStages * 2 + 1;
+
+    static constexpr int lowCutStage(int index) { return index; }
+    static constexpr int peakStage = numCutStages;
+    static constexpr int highCutStage(int index) { return numCutStages + 1 + index; }
+
+    std::array<BiquadCoefficients<float>, numStages> stages;
+
+    // the same stages designed in double precision for the double cascade
+    // (see designPreciseBand), low frequencies at high sample rates put the
+    // poles so close to 1 that float can't tell the coefficients apart anymore
+    std::array<BiquadCoefficients<double>, numStages> preciseStages;
+
+    // a stage is active when its band is not bypassed and
+    // (for the cut filters) the slope needs that section
+    std::array<bool, numStages> active{};
+
+    ChainSettings settings;
+    double sampleRate = 0.0;
+
+    // every band (LowCut, Peak, HighCut) carries the parameter version it was designed for
+    // so the audio thread can skip the bands that didn't change
+    static constexpr int numBands = 3;
+    std::array<juce::uint32, numBands> versions{};
+
+    // how long the cascade keeps ringing after the input stops (see computeTailSamples)
+    int tailSamples = 0;
+
+    // the settings are audibly transparent so the processor can skip the cascade
+    bool neutral = false;
+
+    template<typename NumericType>
+    const std::array<BiquadCoefficients<NumericType>, numStages>& getStages() const
+    {
+        if constexpr (std::is_same<NumericType, double>::value)
+            return preciseStages;
+        else
+            return stages;
+    }
+
+    const BiquadCoefficients<float>* getLowCut() const { return &stages[lowCutStage(0)]; }
+    const BiquadCoefficients<float>* getHighCut() const { return &stages[highCutStage(0)]; }
+};
+
+// each of these only touches its own band, including its fields in set.settings
+// so a band's coefficients always match the settings stored next to them.
+// they use the designers from BiquadDesign.h so none of them allocates
+
+inline void designLowCut(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate)
+{
+    set.settings.lowCutFreq = chainSettings.lowCutFreq;
+    set.settings.lowCutSlope = chainSettings.lowCutSlope;
+    set.settings.lowCutBypassed = chainSettings.lowCutBypassed;
+
+    auto* sections = &set.stages[CoefficientSet::lowCutStage(0)];
+    auto numSections = designLowCutSections(sections, chainSettings.lowCutFreq, sampleRate, chainSettings.lowCutSlope);
+
+    for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+        set.active[CoefficientSet::lowCutStage(i)] = !chainSettings.lowCutBypassed && i < numSections;
+}
+
+inline void designPeak(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate)
+{
+    set.settings.peakFreq = chainSettings.peakFreq;
+    set.settings.peakGainInDecibells = chainSettings.peakGainInDecibells;
+    set.settings.peakQ = chainSettings.peakQ;
+    set.settings.peakBypassed = chainSettings.peakBypassed;
+
+    set.stages[CoefficientSet::peakStage] = designPeakSection(chainSettings.peakFreq,
+        chainSettings.peakQ,
+        chainSettings.peakGainInDecibells,
+        sampleRate);
+    set.active[CoefficientSet::peakStage] = !chainSettings.peakBypassed;
+}
+
+inline void designHighCut(CoefficientSet& set, const ChainSettings& chainSettings, double sampleRate)
+{
+    set.settings.highCutFreq = chainSettings.highCutFreq;
+    set.settings.highCutSlope = chainSettings.highCutSlope;
+    set.settings.highCutBypassed = chainSettings.highCutBypassed;
+
+    auto* sections = &set.stages[CoefficientSet::highCutStage(0)];
+    auto numSections = designHighCutSections(sections, chainSettings.highCutFreq, sampleRate, chainSettings.highCutSlope);
+
+    for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+        set.active[CoefficientSet::highCutStage(i)] = !chainSettings.highCutBypassed && i < numSections;
+}
+
+inline void designBand(CoefficientSet& set, ChainPossitions band, const ChainSettings& chainSettings, double sampleRate)
+{
+    switch (band)
+    {
+    case LowCut:
+        designLowCut(set, chainSettings, sampleRate);
+        break;
+    case Peak:
+        designPeak(set, chainSettings, sampleRate);
+        break;
+    case HighCut:
+        designHighCut(set, chainSettings, sampleRate);
+        break;
+    }
+
+    set.sampleRate = sampleRate;
+}
+
+// designs the preciseStages of one band, the rest of the set comes from designBand
+inline void designPreciseBand(CoefficientSet& set, ChainPossitions band, const ChainSettings& chainSettings, double sampleRate)
+{
+    switch (band)
+    {
+    case LowCut:
+    {
+        auto* sections = &set.preciseStages[CoefficientSet::lowCutStage(0)];
+        designLowCutSections(sections, chainSettings.lowCutFreq, sampleRate, chainSettings.lowCutSlope);
+        break;
+    }
+    case Peak:
+        set.preciseStages[CoefficientSet::peakStage] = designPeakSection<double>(chainSettings.peakFreq,
+            chainSettings.peakQ,
+            chainSettings.peakGainInDecibells,
+            sampleRate);
+        break;
+    case HighCut:
+    {
+        auto* sections = &set.preciseStages[CoefficientSet::highCutStage(0)];
+        designHighCutSections(sections, chainSettings.highCutFreq, sampleRate, chainSettings.highCutSlope);
+        break;
+    }
+    }
+}
+
+//==============================================================
+// the tail is over once the impulse response fell below -120 dB
+static constexpr double tailThreshold = 1.0e-6;
+
+// anything longer than this is treated as 'rings forever'
+static constexpr double maxTailSeconds = 10.0;
+
+// how many samples the impulse response of one stage needs to decay below
+// the threshold. the slowest pole decides that: its contribution shrinks by
+// its radius r every sample, so it needs log(threshold) / log(r) samples
+inline double getStageDecaySamples(const BiquadCoefficients<float>& stage, double threshold)
+{
+    // the poles are the roots of z^2 + a1 z + a2
+    auto a1 = static_cast<double>(stage.a1);
+    auto a2 = static_cast<double>(stage.a2);
+    auto discriminant = a1 * a1 - 4.0 * a2;
+
+    double radius;
+
+    if (discriminant < 0.0)
+    {
+        // a complex pair, both poles have the same radius
+        radius = std::sqrt(a2);
+    }
+    else
+    {
+        auto root = std::sqrt(discriminant);
+        radius = juce::jmax(std::abs(-a1 + root), std::abs(-a1 - root)) * 0.5;
+    }
+
+    // the two zeros still delay things by 2 samples even without feedback
+    if (radius <= 0.0)
+        return 2.0;
+
+    if (radius >= 1.0)
+        return std::numeric_limits<double>::max();
+
+    return std::log(threshold) / std::log(radius) + 2.0;
+}
+
+// the stages run one after the other so their tails add up
+// (that overestimates a little, which is the safe side)
+inline int computeTailSamples(const CoefficientSet& set)
+{
+    auto maxTailSamples = maxTailSeconds * set.sampleRate;
+    double tail = 0.0;
+
+    for (int stage = 0; stage < CoefficientSet::numStages; ++stage)
+    {
+        if (set.active[stage])
+            tail += getStageDecaySamples(set.stages[stage], tailThreshold);
+
+        if (tail >= maxTailSamples)
+            return static_cast<int>(maxTailSamples);
+    }
+
+    return static_cast<int>(std::ceil(tail));
+}
+
+// copies a whole set into a MonoChain whose filters already have
+// 2nd order coefficients (see prepareCoefficientStorage)
+inline void updateMonoChain(MonoChain& chain, const CoefficientSet& set)
+{
+    const auto& chainSettings = set.settings;
+
+    chain.setBypassed<ChainPossitions::LowCut>(chainSettings.lowCutBypassed);
+    chain.setBypassed<ChainPossitions::Peak>(chainSettings.peakBypassed);
+    chain.setBypassed<ChainPossitions::HighCut>(chainSettings.highCutBypassed);
+
+    updateCutFilter(chain.get<ChainPossitions::LowCut>(), set.getLowCut(), chainSettings.lowCutSlope);
+    updateCoefficients(chain.get<ChainPossitions::Peak>().coefficients, set.stages[CoefficientSet::peakStage]);
+    updateCutFilter(chain.get<ChainPossitions::HighCut>(), set.getHighCut(), chainSettings.highCutSlope);
+}
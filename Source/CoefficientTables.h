@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    CoefficientTables.h
+    Created: 16 Oct 2026 4:03:17pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <map>
+#include <memory>
+#include <vector>
+#include "CoefficientSet.h"
+
+// precomputed lookup tables so that designing a filter while a knob is
+// being automated is a couple of table fetches instead of tan/sin/cos calls.
+//
+// instead of storing whole biquads over a frequency x Q x gain grid
+// the tables hold the parts of the juce formulas that need the expensive
+// functions and the rest is a handful of multiplies:
+// - per frequency (log spaced, interpolated): tan and cot of pi*f/sr for the
+//   butterworth sections and cos/sin of 2*pi*f/sr for the peak filter.
+//   finding a frequency on that grid takes one log per band, the up to four
+//   sections of a cut all share the same lookup (see lookupFrequency)
+// - per gain (every 0.1 dB like the "Peak Gain" parameter): sqrt of the gain factor
+// the Q of every butterworth section comes from the constexpr butterworthQ table
+// and Q itself only ever divides, so it doesn't need a table.
+//
+// a set of tables only depends on the sample rate so every instance that
+// runs at the same rate shares the same one (see getFor)
+struct CoefficientTables
+{
+    static constexpr int numFrequencies = 4096;
+    static constexpr float minFrequency = 20.f;
+    static constexpr float maxFrequency = 20000.f;
+
+    static constexpr float minGainInDecibells = -24.f;
+    static constexpr float maxGainInDecibells = 24.f;
+    static constexpr float gainStepInDecibells = 0.1f;
+
+    explicit CoefficientTables(double rate) :
+        sampleRate(rate),
+        topFrequency(juce::jmin(maxFrequency, static_cast<float>(rate * 0.49)))
+    {
+        auto logRange = std::log(static_cast<double>(topFrequency) / minFrequency);
+        frequencyToIndex = static_cast<float>((numFrequencies - 1) / logRange);
+
+        frequencies.resize(numFrequencies);
+
+        for (int i = 0; i < numFrequencies; ++i)
+        {
+            auto frequency = minFrequency * std::exp(logRange * i / (numFrequencies - 1));
+            auto theta = juce::MathConstants<double>::pi * frequency / sampleRate;
+
+            frequencies[i].tanTheta = static_cast<float>(std::tan(theta));
+            frequencies[i].cotTheta = static_cast<float>(1.0 / std::tan(theta));
+            frequencies[i].cosOmega = static_cast<float>(std::cos(2.0 * theta));
+            frequencies[i].sinOmega = static_cast<float>(std::sin(2.0 * theta));
+        }
+
+        auto numGains = juce::roundToInt((maxGainInDecibells - minGainInDecibells) / gainStepInDecibells) + 1;
+        gainRoots.resize(static_cast<size_t>(numGains));
+
+        for (int i = 0; i < numGains; ++i)
+        {
+            auto gainInDecibells = minGainInDecibells + i * gainStepInDecibells;
+            gainRoots[i] = std::sqrt(juce::Decibels::decibelsToGain(gainInDecibells));
+        }
+    }
+
+    // the tables for this sample rate, built the first time someone asks
+    // for it and kept for as long as an instance holds on to it.
+    // not realtime safe, call it from prepareToPlay
+    static std::shared_ptr<const CoefficientTables> getFor(double sampleRate)
+    {
+        static juce::CriticalSection registryLock;
+        static std::map<double, std::weak_ptr<const CoefficientTables>> registry;
+
+        const juce::ScopedLock sl(registryLock);
+
+        auto& entry = registry[sampleRate];
+
+        if (auto existing = entry.lock())
+            return existing;
+
+        auto tables = std::make_shared<const CoefficientTables>(sampleRate);
+        entry = tables;
+
+        return tables;
+    }
+
+    size_t getMemorySizeBytes() const
+    {
+        return sizeof(*this)
+            + frequencies.size() * sizeof(FrequencyEntry)
+            + gainRoots.size() * sizeof(float);
+    }
+
+    double getSampleRate() const { return sampleRate; }
+
+    // the interpolated table values for one frequency. finding the spot on the
+    // log spaced grid takes a log, so a band looks its frequency up once here
+    // and hands the entry to every one of its sections
+    struct FrequencyEntry
+    {
+        float tanTheta, cotTheta, cosOmega, sinOmega;
+    };
+
+    // linear interpolation between the two closest grid points
+    FrequencyEntry lookupFrequency(float frequency) const
+    {
+        frequency = juce::jlimit(minFrequency, topFrequency, frequency);
+
+        auto position = std::log(frequency / minFrequency) * frequencyToIndex;
+        auto index = juce::jmin(static_cast<int>(position), numFrequencies - 2);
+        auto fraction = position - static_cast<float>(index);
+
+        const auto& a = frequencies[index];
+        const auto& b = frequencies[index + 1];
+
+        return { a.tanTheta + (b.tanTheta - a.tanTheta) * fraction,
+                 a.cotTheta + (b.cotTheta - a.cotTheta) * fraction,
+                 a.cosOmega + (b.cosOmega - a.cosOmega) * fraction,
+                 a.sinOmega + (b.sinOmega - a.sinOmega) * fraction };
+    }
+
+    // one section of the juce high pass butterworth (the low cut)
+    BiquadCoefficients<float> getLowCutSection(const FrequencyEntry& entry, Slope slope, int section) const
+    {
+        auto n = entry.tanTheta;
+        auto nSquared = n * n;
+        auto invQ = 1.f / butterworthQ[slope][section];
+        auto c1 = 1.f / (1.f + invQ * n + nSquared);
+
+        return { c1, c1 * -2.f, c1, c1 * 2.f * (nSquared - 1.f), c1 * (1.f - invQ * n + nSquared) };
+    }
+
+    // one section of the juce low pass butterworth (the high cut)
+    BiquadCoefficients<float> getHighCutSection(const FrequencyEntry& entry, Slope slope, int section) const
+    {
+        auto n = entry.cotTheta;
+        auto nSquared = n * n;
+        auto invQ = 1.f / butterworthQ[slope][section];
+        auto c1 = 1.f / (1.f + invQ * n + nSquared);
+
+        return { c1, c1 * 2.f, c1, c1 * 2.f * (1.f - nSquared), c1 * (1.f - invQ * n + nSquared) };
+    }
+
+    // same as juce::dsp::IIR::Coefficients::makePeakFilter
+    BiquadCoefficients<float> getPeak(float frequency, float q, float gainInDecibells) const
+    {
+        auto entry = lookupFrequency(frequency);
+        auto A = lookupGainRoot(gainInDecibells);
+
+        auto alpha = entry.sinOmega / (q * 2.f);
+        auto c2 = -2.f * entry.cosOmega;
+        auto alphaTimesA = alpha * A;
+        auto alphaOverA = alpha / A;
+
+        auto a0 = 1.f / (1.f + alphaOverA);
+
+        return { (1.f + alphaTimesA) * a0, c2 * a0, (1.f - alphaTimesA) * a0, c2 * a0, (1.f - alphaOverA) * a0 };
+    }
+
+private:
+    double sampleRate;
+    float topFrequency;
+    float frequencyToIndex;
+
+    std::vector<FrequencyEntry> frequencies;
+    std::vector<float> gainRoots;
+
+    float lookupGainRoot(float gainInDecibells) const
+    {
+        gainInDecibells = juce::jlimit(minGainInDecibells, maxGainInDecibells, gainInDecibells);
+
+        auto position = (gainInDecibells - minGainInDecibells) / gainStepInDecibells;
+        auto index = juce::jmin(static_cast<int>(position), static_cast<int>(gainRoots.size()) - 2);
+        auto fraction = position - static_cast<float>(index);
+
+        return gainRoots[index] + (gainRoots[index + 1] - gainRoots[index]) * fraction;
+    }
+};
+
+// the same as designBand but with the coefficients fetched from the tables
+inline void designBand(CoefficientSet& set, ChainPossitions band, const ChainSettings& chainSettings, const CoefficientTables& tables)
+{
+    switch (band)
+    {
+    case LowCut:
+    {
+        set.settings.lowCutFreq = chainSettings.lowCutFreq;
+        set.settings.lowCutSlope = chainSettings.lowCutSlope;
+        set.settings.lowCutBypassed = chainSettings.lowCutBypassed;
+
+        auto entry = tables.lookupFrequency(chainSettings.lowCutFreq);
+
+        for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+        {
+            auto stage = CoefficientSet::lowCutStage(i);
+            set.active[stage] = !chainSettings.lowCutBypassed && i < getNumSections(chainSettings.lowCutSlope);
+
+            if (i < getNumSections(chainSettings.lowCutSlope))
+                set.stages[stage] = tables.getLowCutSection(entry, chainSettings.lowCutSlope, i);
+        }
+        break;
+    }
+    case Peak:
+        set.settings.peakFreq = chainSettings.peakFreq;
+        set.settings.peakGainInDecibells = chainSettings.peakGainInDecibells;
+        set.settings.peakQ = chainSettings.peakQ;
+        set.settings.peakBypassed = chainSettings.peakBypassed;
+
+        set.stages[CoefficientSet::peakStage] = tables.getPeak(chainSettings.peakFreq, chainSettings.peakQ, chainSettings.peakGainInDecibells);
+        set.active[CoefficientSet::peakStage] = !chainSettings.peakBypassed;
+        break;
+    case HighCut:
+    {
+        set.settings.highCutFreq = chainSettings.highCutFreq;
+        set.settings.highCutSlope = chainSettings.highCutSlope;
+        set.settings.highCutBypassed = chainSettings.highCutBypassed;
+
+        auto entry = tables.lookupFrequency(chainSettings.highCutFreq);
+
+        for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+        {
+            auto stage = CoefficientSet::highCutStage(i);
+            set.active[stage] = !chainSettings.highCutBypassed && i < getNumSections(chainSettings.highCutSlope);
+
+            if (i < getNumSections(chainSettings.highCutSlope))
+                set.stages[stage] = tables.getHighCutSection(entry, chainSettings.highCutSlope, i);
+        }
+        break;
+    }
+    }
+
+    set.sampleRate = tables.getSampleRate();
+}
@@ -16,13 +16,32 @@ struct FFTDataGenerator
 {
     //produces the FFT data from an audio buffer
 
+    // the transform is done right in the next slot of the fifo,
+    // with the fifo full the frame is skipped before any work is done
     void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    {
+        produceFFTDataForRendering(audioData.getReadPointer(0), getFFTSize(), nullptr, 0, negativeInfinity);
+    }
+
+    // the same for a window that wraps around a circular buffer:
+    // the oldest 'olderSize' samples first, then the 'newerSize' newest ones
+    void produceFFTDataForRendering(const float* older, int olderSize,
+        const float* newer, int newerSize,
+        const float negativeInfinity)
     {
         const auto fftSize = getFFTSize();
+        jassert(olderSize + newerSize == fftSize);
+
+        auto* slot = fftDataFifo.acquireWrite();
+
+        if (slot == nullptr)
+            return;
+
+        auto& fftData = *slot;
         
-        fftData.assign(fftData.size(), 0);
-        auto* readIndex = audioData.getReadPointer(0);
-        std::copy(readIndex, readIndex + fftSize, fftData.begin());
+        std::fill(fftData.begin() + fftSize, fftData.end(), 0.f);
+        std::copy(older, older + olderSize, fftData.begin());
+        std::copy(newer, newer + newerSize, fftData.begin() + olderSize);
 
         //first apply a windowing functionto our data
         window->multiplyWithWindowingTable(fftData.data(), fftSize);
@@ -43,7 +62,7 @@ struct FFTDataGenerator
         {
             fftData[i] = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
         }
-    fftDataFifo.push(fftData);
+    fftDataFifo.commitWrite();
     }   
 
 
@@ -59,10 +78,8 @@ struct FFTDataGenerator
         forwardFFT = std::make_unique<juce::dsp::FFT>(order);
         window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
 
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
-
-        fftDataFifo.prepare(fftData.size());
+        // the transform works in place and needs twice the fft size
+        fftDataFifo.prepare(static_cast<size_t>(fftSize * 2));
     }
 
 
@@ -71,9 +88,13 @@ struct FFTDataGenerator
     int getNumAvailiableFFTDataBlocks() const { return fftDataFifo.getNumAvailiableForReading(); }
     //============================================================
     bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
+
+    // the oldest frame where it sits in the fifo, hand it back with releaseFFTData()
+    const BlockType* acquireFFTData() { return fftDataFifo.acquireRead(); }
+    void releaseFFTData() { fftDataFifo.releaseRead(); }
+    void discardAll() { fftDataFifo.discardAll(); }
 private:
     FFTOrder order;
-    BlockType fftData;
     std::unique_ptr<juce::dsp::FFT> forwardFFT;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
 
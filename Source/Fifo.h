@@ -10,7 +10,14 @@
 
 #pragma once
 #include<array>
-template<typename T>
+
+// a single producer, single consumer queue of Capacity preallocated slots.
+// push and pull copy a whole T in and out, the acquire / commit and
+// acquire / release pairs hand out the slot itself so the writer can fill it
+// and the reader can use it where it is, without copying or reallocating anything.
+// only one slot per side can be acquired at a time and it stays put until it is
+// committed or released
+template<typename T, int Capacity = 30>
 struct Fifo
 {
     void prepare(int numChannels, int numSamples)
@@ -45,10 +52,10 @@ struct Fifo
 
     bool push(const T& t)
     {
-        auto write = fifo.write(1);
-        if (write.blockSize1 > 0)
+        if (auto* slot = acquireWrite())
         {
-            buffers[write.startIndex1] = t;
+            *slot = t;
+            commitWrite();
             return true;
         }
         return false;
@@ -56,21 +63,55 @@ struct Fifo
 
     bool pull(T& t)
     {
-        auto read = fifo.read(1);
-        if (read.blockSize1 > 0)
+        if (auto* slot = acquireRead())
         {
-            t = buffers[read.startIndex1];
+            t = *slot;
+            releaseRead();
             return true;
         }
         return false;
     }
 
+    //==============================================================
+    // writer side
+    // the next free slot, still holding whatever was in it before,
+    // or nullptr when the reader hasn't caught up yet
+    T* acquireWrite()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        return size1 > 0 ? &buffers[static_cast<size_t>(start1)] : nullptr;
+    }
+
+    // hands the acquired slot over to the reader
+    void commitWrite() { fifo.finishedWrite(1); }
+
+    //==============================================================
+    // reader side
+    // the oldest slot the writer committed, or nullptr when there is none.
+    // the writer won't touch it until it is released
+    T* acquireRead()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+
+        return size1 > 0 ? &buffers[static_cast<size_t>(start1)] : nullptr;
+    }
+
+    // gives the acquired slot back to the writer
+    void releaseRead() { fifo.finishedRead(1); }
+
+    // throws away everything that is waiting
+    void discardAll() { fifo.finishedRead(fifo.getNumReady()); }
+
     int getNumAvailiableForReading() const
     {
         return fifo.getNumReady();
     }
 private:
-    static constexpr int Capacity = 30;
+    static_assert(Capacity > 0, "a Fifo needs at least one slot");
+
     std::array<T, Capacity> buffers;
     juce::AbstractFifo fifo{ Capacity };
 };
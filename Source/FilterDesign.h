@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    FilterDesign.h
+    Created: 16 Oct 2026 9:12:40am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Slope.h"
+#include "ChainSettings.h"
+#include "ChainPossitions.h"
+#include "BiquadCoefficients.h"
+
+// Create namespace aliases
+// this is a generic IIR filter class that can be used to represent 
+// a single cut or peak filter
+using Filter = juce::dsp::IIR::Filter<float>;
+
+// the default juce IIR cut filters slope is 12 db/Oct 
+// so we need 4 to acheive 48 db/Oct slope
+// we will use the same processor chain for both cut filters 
+// since they have the same architecture
+using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+
+using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+
+// this helper function is used to update coefficients
+// we make an alias to the type juce uses for the coeffs 
+using Coefficients = Filter::CoefficientsPtr;
+
+inline void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+{
+    *old = *replacements;
+}
+
+// same as above but for the plain coefficient sets that the CoefficientService
+// publishes, this one only writes into the existing array so it never allocates
+inline void updateCoefficients(Coefficients& old, const BiquadCoefficients<float>& replacements)
+{
+    replacements.copyTo(*old);
+}
+
+inline Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    // calculate coefficients using the juce helper funcions
+    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
+        chainSettings.peakFreq,
+        chainSettings.peakQ,
+        juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibells));
+}
+
+
+template<int Index, typename ChainType, typename CoefficientType>
+void update(ChainType& chain, CoefficientType& coefficients)
+{
+    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
+    chain.template setBypassed<Index>(false);
+}
+
+
+
+// we are not sure what typenames to use 
+// for the parameters of our low cut update function 
+// so we use a templated function
+template<typename ChainType, typename CoefficientType>
+void updateCutFilter(ChainType& cut,
+    const CoefficientType& cutCoefficients,
+    const Slope& cutSlope)
+{
+
+    // compiles without the template keyword ??
+    cut.template setBypassed<0>(true);
+    cut.template setBypassed<1>(true);
+    cut.template setBypassed<2>(true);
+    cut.template setBypassed<3>(true);
+
+
+
+    // now for each setting we will assign the respective set of coeffs and unbypass it
+    // if we reverse the switch order we can leverage
+    // case passthrough to eliminate code duplication
+    // we dont break our switch statement
+    switch (cutSlope)
+    {
+    case Slope_48:
+        update<3>(cut, cutCoefficients);
+    case Slope_36:
+        update<2>(cut, cutCoefficients);
+    case Slope_24:
+        update<1>(cut, cutCoefficients);
+    case Slope_12:
+        update<0>(cut, cutCoefficients);
+    }
+
+}
+
+// if we want to implement theese functions 
+// in header files that are included in more
+// than one place we need to use the inline 
+// keyword otherwise the compiler will produce
+// a definition for this function everywhere
+// that this header file is included and the 
+// linker will not now which version to use
+
+inline auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+     return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
+         sampleRate,
+         (chainSettings.lowCutSlope + 1) * 2);
+}
+inline auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
+        sampleRate,
+        (chainSettings.highCutSlope + 1) * 2);
+}
+
+// the juce filters start out with a 1st order coefficients object
+// the audio thread only copies values into the existing arrays
+// so every filter needs a 2nd order one before we start processing
+inline void prepareCoefficientStorage(Filter& filter)
+{
+    filter.coefficients = new juce::dsp::IIR::Coefficients<float>(1.f, 0.f, 0.f, 1.f, 0.f, 0.f);
+}
+
+inline void prepareCoefficientStorage(CutFilter& cut)
+{
+    prepareCoefficientStorage(cut.get<0>());
+    prepareCoefficientStorage(cut.get<1>());
+    prepareCoefficientStorage(cut.get<2>());
+    prepareCoefficientStorage(cut.get<3>());
+}
+
+inline void prepareCoefficientStorage(MonoChain& chain)
+{
+    prepareCoefficientStorage(chain.get<ChainPossitions::LowCut>());
+    prepareCoefficientStorage(chain.get<ChainPossitions::Peak>());
+    prepareCoefficientStorage(chain.get<ChainPossitions::HighCut>());
+}
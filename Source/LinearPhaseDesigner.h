@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    LinearPhaseDesigner.h
+    Created: 16 Oct 2026 7:58:03pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "CoefficientService.h"
+#include "PartitionedConvolver.h"
+
+// the magnitude response of one biquad, like
+// juce::dsp::IIR::Coefficients::getMagnitudeForFrequency
+inline double getMagnitudeForFrequency(const BiquadCoefficients<float>& stage, double frequency, double sampleRate)
+{
+    auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    auto z1 = std::polar(1.0, -omega);
+    auto z2 = z1 * z1;
+
+    auto numerator = static_cast<double>(stage.b0) + static_cast<double>(stage.b1) * z1 + static_cast<double>(stage.b2) * z2;
+    auto denominator = 1.0 + static_cast<double>(stage.a1) * z1 + static_cast<double>(stage.a2) * z2;
+
+    return std::abs(numerator / denominator);
+}
+
+// turns the magnitude response of the published coefficients (the same curve
+// the ResponseCurveComponent draws) into a symmetric, linear phase FIR and
+// publishes its partition spectra for the PartitionedConvolver.
+// it runs on the shared CoefficientDesignThread next to the CoefficientService
+// and only does any work while the linear phase mode is on
+struct LinearPhaseDesigner : private juce::TimeSliceClient
+{
+    LinearPhaseDesigner(CoefficientService& service, std::atomic<float>* enabledParameter) :
+        coefficientService(service),
+        enabled(enabledParameter)
+    {
+        designThread->addTimeSliceClient(this);
+    }
+
+    ~LinearPhaseDesigner()
+    {
+        designThread->removeTimeSliceClient(this);
+    }
+
+    // 8192 taps at 44.1/48k, more at higher rates so the low cut keeps its resolution
+    static int getFirOrder(double sampleRate)
+    {
+        if (sampleRate <= 50000.0)
+            return 13;
+
+        return sampleRate <= 100000.0 ? 14 : 15;
+    }
+
+    // allocates the buffers for this sample rate and designs straight away
+    // if the mode is on, don't call it from the audio thread.
+    // whatever kernel is still waiting from the old rate won't be handed out anymore
+    void prepare(double sampleRate)
+    {
+        const juce::ScopedLock sl(designLock);
+
+        currentSampleRate = sampleRate;
+        auto newGeneration = generation.load() + 1;
+
+        auto firOrder = getFirOrder(sampleRate);
+        auto newFirLength = 1 << firOrder;
+        firLength.store(newFirLength);
+
+        firFFT = std::make_unique<juce::dsp::FFT>(firOrder);
+        partitionFFT = std::make_unique<juce::dsp::FFT>(LinearPhaseKernel::partitionOrder + 1);
+
+        firBuffer.assign(static_cast<size_t>(newFirLength * 2), 0.f);
+        partitionBuffer.assign(static_cast<size_t>(LinearPhaseKernel::partitionSize * 4), 0.f);
+        designedKernel.setSize(newFirLength);
+        designedKernel.generation = newGeneration;
+        generation.store(newGeneration);
+
+        designedVersion = 0;
+
+        if (isEnabled())
+            designIfChanged();
+    }
+
+    int getFirLength() const { return firLength.load(); }
+
+    // the FIR is symmetric around its middle, that is where its delay comes from
+    // any thread
+    int getLatencySamples() const { return firLength.load() / 2 + PartitionedConvolver::getLatencySamples(); }
+
+    // audio thread only
+    // returns the newest kernel or nullptr if nothing changed since the last call
+    // or the newest one was designed for the sample rate before the last prepare
+    const LinearPhaseKernel* pullLatest()
+    {
+        if (!publishedKernels.pull())
+            return nullptr;
+
+        auto& kernel = publishedKernels.getReadBuffer();
+        return kernel.generation == generation.load() ? &kernel : nullptr;
+    }
+
+private:
+    CoefficientService& coefficientService;
+    std::atomic<float>* enabled;
+
+    juce::SharedResourcePointer<CoefficientDesignThread> designThread;
+    juce::CriticalSection designLock;
+
+    TripleBuffer<LinearPhaseKernel> publishedKernels;
+
+    // goes up with every prepare, only kernels stamped with the current one are played
+    std::atomic<juce::uint32> generation{ 0 };
+
+    // written in prepare, the latency is read from any thread
+    std::atomic<int> firLength{ 0 };
+
+    // everything below is only touched while holding the designLock
+    double currentSampleRate = 0.0;
+    juce::uint32 designedVersion = 0;
+
+    std::unique_ptr<juce::dsp::FFT> firFFT, partitionFFT;
+    std::vector<float> firBuffer, partitionBuffer;
+
+    CoefficientSet latestDesign;
+    LinearPhaseKernel designedKernel;
+
+    static constexpr int pollIntervalMs = 10;
+
+    bool isEnabled() const { return enabled->load() > 0.5f; }
+
+    int useTimeSlice() override
+    {
+        if (isEnabled())
+        {
+            const juce::ScopedLock sl(designLock);
+            designIfChanged();
+        }
+
+        return pollIntervalMs;
+    }
+
+    void designIfChanged()
+    {
+        if (firFFT == nullptr)
+            return;
+
+        // the service counts its designs, nothing to do if it didn't make a new one
+        auto version = coefficientService.getNumDesigns();
+
+        if (version == 0 || version == designedVersion)
+            return;
+
+        designedVersion = version;
+        coefficientService.copyLatestDesign(latestDesign);
+
+        designKernel();
+
+        publishedKernels.getWriteBuffer() = designedKernel;
+        publishedKernels.publish();
+    }
+
+    void designKernel()
+    {
+        auto* fir = firBuffer.data();
+        auto numTaps = designedKernel.firLength;
+        auto* bins = reinterpret_cast<std::complex<float>*>(fir);
+
+        // the zero phase spectrum: every bin only holds the magnitude of the whole chain
+        for (int bin = 0; bin <= numTaps / 2; ++bin)
+        {
+            auto frequency = bin * currentSampleRate / numTaps;
+            double magnitude = 1.0;
+
+            for (int stage = 0; stage < CoefficientSet::numStages; ++stage)
+            {
+                if (latestDesign.active[stage])
+                    magnitude *= getMagnitudeForFrequency(latestDesign.stages[stage], frequency, currentSampleRate);
+            }
+
+            bins[bin] = { static_cast<float>(magnitude), 0.f };
+        }
+
+        firFFT->performRealOnlyInverseTransform(fir);
+
+        // the impulse comes back centred on sample 0, rotating it by half the
+        // length puts the centre in the middle and makes it causal and symmetric.
+        // a hann window tapers whatever the sampled response cut off at the ends
+        std::rotate(fir, fir + numTaps / 2, fir + numTaps);
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            auto window = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / numTaps);
+            fir[i] *= static_cast<float>(window);
+        }
+
+        // and finally the spectrum of every zero padded partition
+        auto* partitionData = partitionBuffer.data();
+        auto* partitionBins = reinterpret_cast<std::complex<float>*>(partitionData);
+        constexpr auto partitionSize = LinearPhaseKernel::partitionSize;
+
+        for (int partition = 0; partition < designedKernel.numPartitions; ++partition)
+        {
+            std::copy(fir + partition * partitionSize, fir + (partition + 1) * partitionSize, partitionData);
+            std::fill(partitionData + partitionSize, partitionData + partitionSize * 4, 0.f);
+
+            partitionFFT->performRealOnlyForwardTransform(partitionData, true);
+
+            std::copy(partitionBins, partitionBins + LinearPhaseKernel::numBins, designedKernel.getPartition(partition));
+        }
+    }
+};
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    PartitionedConvolver.h
+    Created: 16 Oct 2026 7:34:26pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <complex>
+#include <vector>
+
+// the spectra of a long FIR cut into equal partitions of partitionSize samples.
+// every partition is zero padded to twice its length before the FFT
+// so only the partitionSize + 1 non negative bins need to be stored
+struct LinearPhaseKernel
+{
+    static constexpr int partitionOrder = 9;
+    static constexpr int partitionSize = 1 << partitionOrder;
+    static constexpr int numBins = partitionSize + 1;
+
+    int firLength = 0;
+    int numPartitions = 0;
+    std::vector<std::complex<float>> spectra;
+
+    // which LinearPhaseDesigner::prepare it was designed after, a kernel from
+    // before the last sample rate change must never be played
+    juce::uint32 generation = 0;
+
+    void setSize(int newFirLength)
+    {
+        jassert(newFirLength % partitionSize == 0);
+
+        firLength = newFirLength;
+        numPartitions = firLength / partitionSize;
+        spectra.assign(static_cast<size_t>(numPartitions * numBins), {});
+    }
+
+    std::complex<float>* getPartition(int index) { return spectra.data() + index * numBins; }
+    const std::complex<float>* getPartition(int index) const { return spectra.data() + index * numBins; }
+};
+
+// uniformly partitioned overlap-save convolution.
+// the input is collected into partitions of partitionSize samples, every full
+// partition goes through one FFT into a frequency domain delay line, gets
+// multiplied with the kernel partitions and comes back with one inverse FFT.
+//
+// only the newest input frame has to wait for the end of its partition, every
+// older one is already in the delay line. so the multiply-adds of kernel
+// partitions 1 to numPartitions - 1 for the next output are spread over the
+// samples of the partition before it, a callback does its share in proportion
+// to its length. what is left for the callback that completes a partition is
+// the FFT pair and the multiply-adds of kernel partition 0, per channel.
+// the total still grows linearly with the FIR length, that comes with uniform
+// partitions. the output is exactly partitionSize samples late
+struct PartitionedConvolver
+{
+    static constexpr int partitionSize = LinearPhaseKernel::partitionSize;
+    static constexpr int numBins = LinearPhaseKernel::numBins;
+
+    // allocates everything, not realtime safe
+    void prepare(int newNumChannels, int newNumPartitions)
+    {
+        numChannels = newNumChannels;
+        numPartitions = newNumPartitions;
+        kernel = nullptr;
+
+        inputFrames.assign(static_cast<size_t>(numChannels * partitionSize * 2), 0.f);
+        outputs.assign(static_cast<size_t>(numChannels * partitionSize), 0.f);
+        delayLine.assign(static_cast<size_t>(numChannels * numPartitions * numBins), {});
+
+        fftBuffer.assign(static_cast<size_t>(partitionSize * 4), 0.f);
+        accumulators.assign(static_cast<size_t>(numChannels * numBins), {});
+
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(inputFrames.begin(), inputFrames.end(), 0.f);
+        std::fill(outputs.begin(), outputs.end(), 0.f);
+        std::fill(delayLine.begin(), delayLine.end(), std::complex<float>());
+        std::fill(accumulators.begin(), accumulators.end(), std::complex<float>());
+
+        inputPosition = 0;
+        delayLinePosition = 0;
+        numPartitionsAccumulated = 1;
+    }
+
+    // the kernel has to stay alive until the next setKernel call.
+    // kernels designed for another size are ignored, prepare() forgets the
+    // current one so nothing from before it is played afterwards.
+    // one that arrives in the middle of a partition takes over from the next
+    // kernel partition on, the output partition in between mixes the two
+    void setKernel(const LinearPhaseKernel* newKernel)
+    {
+        if (newKernel != nullptr && newKernel->numPartitions == numPartitions)
+            kernel = newKernel;
+    }
+
+    bool hasKernel() const { return kernel != nullptr; }
+
+    static constexpr int getLatencySamples() { return partitionSize; }
+
+    void process(float* const* channels, int numChannelsToProcess, int numSamples)
+    {
+        jassert(numChannelsToProcess <= numChannels);
+        numChannelsToProcess = juce::jmin(numChannelsToProcess, numChannels);
+
+        for (int done = 0; done < numSamples;)
+        {
+            auto numToCopy = juce::jmin(partitionSize - inputPosition, numSamples - done);
+
+            for (int ch = 0; ch < numChannelsToProcess; ++ch)
+            {
+                auto* channel = channels[ch] + done;
+
+                std::copy(channel, channel + numToCopy, getInputFrame(ch) + partitionSize + inputPosition);
+                std::copy(getOutput(ch) + inputPosition, getOutput(ch) + inputPosition + numToCopy, channel);
+            }
+
+            inputPosition += numToCopy;
+            done += numToCopy;
+
+            accumulateUpTo(1 + (numPartitions - 1) * inputPosition / partitionSize, numChannelsToProcess);
+
+            if (inputPosition == partitionSize)
+            {
+                processPartition(numChannelsToProcess);
+                inputPosition = 0;
+            }
+        }
+    }
+
+private:
+    juce::dsp::FFT fft{ LinearPhaseKernel::partitionOrder + 1 };
+
+    int numChannels = 0;
+    int numPartitions = 0;
+    const LinearPhaseKernel* kernel = nullptr;
+
+    // per channel: the last two partitions of input, the newest one in the second half
+    std::vector<float> inputFrames;
+    // per channel: the partition that is being played back
+    std::vector<float> outputs;
+    // per channel: the spectra of the last numPartitions input frames
+    std::vector<std::complex<float>> delayLine;
+
+    std::vector<float> fftBuffer;
+    // per channel: the sum for the next output partition so far
+    std::vector<std::complex<float>> accumulators;
+
+    int inputPosition = 0;
+    // the slot the next input frame goes into
+    int delayLinePosition = 0;
+    // the kernel partitions that are in the accumulators, 0 is always added last
+    int numPartitionsAccumulated = 1;
+
+    float* getInputFrame(int channel) { return inputFrames.data() + channel * partitionSize * 2; }
+    float* getOutput(int channel) { return outputs.data() + channel * partitionSize; }
+
+    std::complex<float>* getDelayLineSlot(int channel, int slot)
+    {
+        return delayLine.data() + (channel * numPartitions + slot) * numBins;
+    }
+
+    std::complex<float>* getAccumulator(int channel) { return accumulators.data() + channel * numBins; }
+
+    // adds the input frame that lines up with the kernel partition
+    void multiplyAdd(int channel, int partition)
+    {
+        auto slot = (delayLinePosition - partition + numPartitions) % numPartitions;
+        auto* input = getDelayLineSlot(channel, slot);
+        auto* response = kernel->getPartition(partition);
+        auto* accumulator = getAccumulator(channel);
+
+        for (int bin = 0; bin < numBins; ++bin)
+            accumulator[bin] += input[bin] * response[bin];
+    }
+
+    // the older frames' share of the next output, a bit more with every call
+    void accumulateUpTo(int partitionsToHave, int numChannelsToProcess)
+    {
+        if (kernel != nullptr)
+        {
+            for (int partition = numPartitionsAccumulated; partition < partitionsToHave; ++partition)
+            {
+                for (int ch = 0; ch < numChannelsToProcess; ++ch)
+                    multiplyAdd(ch, partition);
+            }
+        }
+
+        numPartitionsAccumulated = juce::jmax(numPartitionsAccumulated, partitionsToHave);
+    }
+
+    void processPartition(int numChannelsToProcess)
+    {
+        auto* fftData = fftBuffer.data();
+        auto* fftBins = reinterpret_cast<std::complex<float>*>(fftData);
+
+        for (int ch = 0; ch < numChannelsToProcess; ++ch)
+        {
+            auto* frame = getInputFrame(ch);
+            auto* accumulator = getAccumulator(ch);
+
+            // the newest input frame goes into the delay line
+            std::copy(frame, frame + partitionSize * 2, fftData);
+            std::fill(fftData + partitionSize * 2, fftData + partitionSize * 4, 0.f);
+
+            fft.performRealOnlyForwardTransform(fftData, true);
+            std::copy(fftBins, fftBins + numBins, getDelayLineSlot(ch, delayLinePosition));
+
+            // every earlier frame is in the accumulator already, only the newest one is missing
+            if (kernel != nullptr)
+                multiplyAdd(ch, 0);
+
+            std::copy(accumulator, accumulator + numBins, fftBins);
+            fft.performRealOnlyInverseTransform(fftData);
+
+            // overlap-save: the first half wrapped around, the second half is the output
+            std::copy(fftData + partitionSize, fftData + partitionSize * 2, getOutput(ch));
+
+            // the newest frame becomes the older half for the next partition
+            std::copy(frame + partitionSize, frame + partitionSize * 2, frame);
+
+            std::fill(accumulator, accumulator + numBins, std::complex<float>());
+        }
+
+        delayLinePosition = (delayLinePosition + 1) % numPartitions;
+        numPartitionsAccumulated = 1;
+    }
+};
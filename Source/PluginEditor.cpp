@@ -280,6 +280,8 @@ ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& p) :
      
     updateChain();
 
+    toggleAnalysisEnablement(audioProcessor.apvts.getRawParameterValue("Analyser Enabled")->load() > 0.5f);
+
     startTimerHz(60);
 
 }
@@ -292,6 +294,42 @@ ResponseCurveComponent::~ResponseCurveComponent()
     {
         param->removeListener(this);
     }
+
+    toggleAnalysisEnablement(false);
+}
+
+void ResponseCurveComponent::toggleAnalysisEnablement(bool enabled)
+{
+    shouldShowFFTAnalysis = enabled;
+    updateAnalyserConsumer();
+}
+
+void ResponseCurveComponent::visibilityChanged()
+{
+    updateAnalyserConsumer();
+}
+
+void ResponseCurveComponent::updateAnalyserConsumer()
+{
+    // a minimised window doesn't tell its children, the timer catches that one
+    auto shouldConsume = shouldShowFFTAnalysis && isShowing();
+
+    if (shouldConsume == consumingAnalyser)
+        return;
+
+    consumingAnalyser = shouldConsume;
+
+    if (shouldConsume)
+    {
+        // whatever is left from before it was hidden is stale
+        leftPathProducer.reset();
+        rightPathProducer.reset();
+        audioProcessor.addAnalyserConsumer();
+    }
+    else
+    {
+        audioProcessor.removeAnalyserConsumer();
+    }
 }
 
 
@@ -300,69 +338,143 @@ void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float new
     parametersChanged.set(true);
 }
 
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+void PathProducer::reset()
 {
-    // gonna send it to the fft data generator 
-    juce::AudioBuffer<float> tempIncomingBuffer;
+    // no worker may be in the middle of it while everything gets cleared
+    analyserPool->cancel(*this);
+
+    leftChannelFifo->discardAll();
+    monoBuffer.clear();
+    writePosition = 0;
+    samplesSinceLastFrame = 0;
+    leftChannelFFTDataGenerator.discardAll();
+    pathProducer.discardAll();
+    leftChannelFFTPath.clear();
+}
+
+void PathProducer::readIntoMonoBuffer(int numSamples)
+{
+    auto size = monoBuffer.getNumSamples();
 
-    //  while there are buffers to pull
-    while (leftChannelFifo->getNumCompleteBuffersAvailiable() > 0)
+    // more than the buffer holds, only the newest samples would survive anyway
+    if (numSamples > size)
     {
-        // if we can pull this buffer
-        if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
-        {
-            // we are gonna send it to the fft data generator
-            auto size = tempIncomingBuffer.getNumSamples();
+        leftChannelFifo->discardSamples(numSamples - size);
+        numSamples = size;
+    }
+
+    while (numSamples > 0)
+    {
+        auto numToRead = juce::jmin(numSamples, size - writePosition);
+        auto numRead = leftChannelFifo->readSamples(monoBuffer.getWritePointer(0, writePosition), numToRead);
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-                monoBuffer.getReadPointer(0, size),
-                monoBuffer.getNumSamples() - size);
+        if (numRead == 0)
+            return;
 
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                tempIncomingBuffer.getReadPointer(0, 0),
-                size);
+        writePosition = (writePosition + numRead) % size;
+        numSamples -= numRead;
+    }
+}
 
+void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    auto numAvailable = leftChannelFifo->getNumSamplesAvailable();
+    auto untilNextHop = hopSize - samplesSinceLastFrame;
 
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, -48.f);
+    if (numAvailable >= untilNextHop)
+    {
+        // only the newest hop that is complete gets a frame, the
+        // ones before it would be drawn over before anyone saw them
+        auto numHops = 1 + (numAvailable - untilNextHop) / hopSize;
+        auto untilLastHop = untilNextHop + (numHops - 1) * hopSize;
 
+        readIntoMonoBuffer(untilLastHop);
 
-        }
+        // the window is the whole circular buffer, starting at the oldest sample
+        auto* samples = monoBuffer.getReadPointer(0);
+        auto size = monoBuffer.getNumSamples();
+
+        leftChannelFFTDataGenerator.produceFFTDataForRendering(samples + writePosition, size - writePosition,
+            samples, writePosition,
+            -48.f);
+
+        numAvailable -= untilLastHop;
+        samplesSinceLastFrame = 0;
     }
 
+    // the rest counts towards the next hop
+    readIntoMonoBuffer(numAvailable);
+    samplesSinceLastFrame += numAvailable;
+
     const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
 
     const auto binWidth = sampleRate / (double)fftSize;
 
-    while (leftChannelFFTDataGenerator.getNumAvailiableFFTDataBlocks() > 0)
+    // the frames get turned into paths where they are in the fifo
+    while (auto* fftData = leftChannelFFTDataGenerator.acquireFFTData())
     {
-        std::vector<float> fftData;
-        if (leftChannelFFTDataGenerator.getFFTData(fftData));
-        {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, -48.f);
+        pathProducer.generatePath(*fftData, fftBounds, fftSize, binWidth, -48.f);
+        leftChannelFFTDataGenerator.releaseFFTData();
+    }
+}
 
-        }
+void PathProducer::submit(juce::Rectangle<float> fftBounds, double sampleRate, bool visible, double deadlineMs)
+{
+    {
+        const juce::SpinLock::ScopedLockType sl(requestLock);
+        requestedBounds = fftBounds;
+        requestedSampleRate = sampleRate;
     }
-    
+
+    analyserPool->submit(*this, visible, deadlineMs);
+}
+
+void PathProducer::runAnalysis()
+{
+    juce::Rectangle<float> fftBounds;
+    double sampleRate;
+
+    {
+        const juce::SpinLock::ScopedLockType sl(requestLock);
+        fftBounds = requestedBounds;
+        sampleRate = requestedSampleRate;
+    }
+
+    if (sampleRate > 0.0)
+        process(fftBounds, sampleRate);
+}
+
+void PathProducer::pullLatestPath()
+{
     /*while there are paths that can be pulled
     pull as many as you can 
     display the most recent*/
 
     while (pathProducer.getNumPathsAvailiable())
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        pathProducer.swapPath(leftChannelFFTPath);
     }
 }
 
 
 void ResponseCurveComponent::timerCallback()
 {
-    if (shouldShowFFTAnalysis)
+    updateAnalyserConsumer();
+
+    if (consumingAnalyser)
     {
         auto fftBounds = getAnalysisArea().toFloat();
         auto sampleRate = audioProcessor.getSampleRate();
-        
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+
+        // the paths from the last tick, the new ones are made on the
+        // analyser workers and are only worth making until the next repaint or so
+        leftPathProducer.pullLatestPath();
+        rightPathProducer.pullLatestPath();
+
+        auto deadline = juce::Time::getMillisecondCounterHiRes() + 2.0 * getTimerInterval();
+
+        leftPathProducer.submit(fftBounds, sampleRate, isShowing(), deadline);
+        rightPathProducer.submit(fftBounds, sampleRate, isShowing(), deadline);
     }
     
 
@@ -698,6 +810,78 @@ juce::Rectangle<int> ResponseCurveComponent::getAnalysisArea()
 
 
 
+void CpuLoadOverlay::visibilityChanged()
+{
+    if (isShowing())
+    {
+        timerCallback();
+        startTimerHz(4);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void CpuLoadOverlay::timerCallback()
+{
+    statistics = audioProcessor.getBlockLoadStatistics();
+    tableBytes = audioProcessor.getCoefficientTableMemoryBytes();
+    repaint();
+}
+
+void CpuLoadOverlay::paint(juce::Graphics& g)
+{
+    using namespace juce;
+
+    auto percent = [](double load) { return String(load * 100.0, load < 0.1 ? 2 : 1) + "%"; };
+
+    auto text = "p50 " + percent(statistics.p50)
+        + "  p99 " + percent(statistics.p99)
+        + "  max " + percent(statistics.max)
+        + "  over " + String(statistics.numOverBudget) + "/" + String(statistics.numBlocks)
+        + "  tables " + String(static_cast<int>(tableBytes / 1024)) + " kB";
+
+    g.setColour(Colours::black.withAlpha(0.8f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 3.f);
+
+    g.setColour(statistics.numOverBudget > 0 ? Colours::orange : Colours::lightgrey);
+    g.setFont(12);
+    g.drawFittedText(text, getLocalBounds().reduced(4, 0), Justification::centredRight, 1);
+}
+
+void PrecisionFallbackNotice::timerCallback()
+{
+    juce::StringArray modes;
+
+    if (audioProcessor.isLinearPhaseFallingBack())
+        modes.add("Linear Phase");
+
+    if (audioProcessor.isFilterTopologyFallingBack())
+        modes.add("State Variable");
+
+    auto newText = modes.isEmpty() ? juce::String()
+                                   : "64 bit host: " + modes.joinIntoString(" and ") + " off, float only";
+
+    if (newText != text)
+    {
+        text = newText;
+        repaint();
+    }
+}
+
+void PrecisionFallbackNotice::paint(juce::Graphics& g)
+{
+    using namespace juce;
+
+    if (text.isEmpty())
+        return;
+
+    g.setColour(Colours::orange);
+    g.setFont(12);
+    g.drawFittedText(text, getLocalBounds(), Justification::centredLeft, 1);
+}
+
 //==============================================================================
 SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor(SimpleEQAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p),
@@ -710,6 +894,8 @@ SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor(SimpleEQAudioProcesso
     highCutSlopeSlider(*audioProcessor.apvts.getParameter("HighCut Slope" ), "db/Oct"),
 
     responseCurveComponent(audioProcessor),
+    cpuLoadOverlay(audioProcessor),
+    precisionFallbackNotice(audioProcessor),
 
     peakFreqSliderAttachment    (audioProcessor.apvts, "Peak Freq",     peakFreqSlider),
     peakGainSliderAttachment    (audioProcessor.apvts, "Peak Gain",     peakGainSlider),
@@ -750,6 +936,11 @@ SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor(SimpleEQAudioProcesso
         addAndMakeVisible(comp);
     }
 
+    addAndMakeVisible(precisionFallbackNotice);
+    addAndMakeVisible(cpuLoadButton);
+    addChildComponent(cpuLoadOverlay);
+    cpuLoadButton.setClickingTogglesState(true);
+
     peakBypassButton.setLookAndFeel(&lnf);
     lowcutBypassButton.setLookAndFeel(&lnf);
     highcutBypassButton.setLookAndFeel(&lnf);
@@ -803,6 +994,12 @@ SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor(SimpleEQAudioProcesso
         }
     };
 
+    cpuLoadButton.onClick = [safePtr]()
+    {
+        if (auto* comp = safePtr.getComponent())
+            comp->cpuLoadOverlay.setVisible(comp->cpuLoadButton.getToggleState());
+    };
+
 
     setSize (600, 480);
 }
@@ -829,6 +1026,18 @@ void SimpleEQAudioProcessorEditor::resized()
     auto bounds = getLocalBounds();
 
     auto analyserEnabledArea = bounds.removeFromTop(25);
+
+    auto cpuLoadArea = analyserEnabledArea.reduced(5, 2);
+    cpuLoadButton.setBounds(cpuLoadArea.removeFromRight(40));
+    cpuLoadArea.removeFromRight(5);
+    cpuLoadOverlay.setBounds(cpuLoadArea.removeFromRight(420));
+
+    // between the analyser button and the cpu button, the overlay goes over it
+    auto noticeArea = analyserEnabledArea.reduced(5, 2);
+    noticeArea.removeFromLeft(105);
+    noticeArea.removeFromRight(45);
+    precisionFallbackNotice.setBounds(noticeArea);
+
     analyserEnabledArea.setWidth(100);
     analyserEnabledArea.setX(5);
     analyserEnabledArea.removeFromTop(2);
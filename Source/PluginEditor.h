@@ -12,6 +12,7 @@
 #include "PluginProcessor.h"
 #include "FFTDataGenerator.h"
 #include "AnalyserPathGenerator.h"
+#include "AnalyserWorkerPool.h"
 
 
 
@@ -67,29 +68,84 @@ private:
 
 };
 
-struct PathProducer
+// the analyser keeps the last fft size samples in a circular buffer and
+// takes a frame every hop (fftSize * (1 - overlap)) samples, but never more
+// than one per call to process(), which the editor makes once per repaint.
+// when the hops come quicker than that only the newest one gets transformed,
+// so what the fft costs follows the display and not the host's block size.
+//
+// process() runs on the AnalyserWorkerPool, the message thread only submits
+// the work and picks the finished paths up with pullLatestPath()
+struct PathProducer : private AnalyserWorkerPool::Client
 {
     PathProducer(SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>& scsf) :
         leftChannelFifo(&scsf)
     {
         leftChannelFFTDataGenerator.changeOrder(FFTOrder::order8192);
         monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
+        monoBuffer.clear();
+        setOverlap(0.75f);
     }
 
+    ~PathProducer() override
+    {
+        // this waits until no worker is using us anymore
+        analyserPool->cancel(*this);
+    }
+
+    // 0 for frames side by side, 0.75 to start a new one every quarter of the fft.
+    // waits for the analysis if a worker is running it
+    void setOverlap(float overlap)
+    {
+        analyserPool->cancel(*this);
 
+        auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
+        hopSize = juce::jlimit(1, fftSize, juce::roundToInt(fftSize * (1.f - overlap)));
+        samplesSinceLastFrame = juce::jmin(samplesSinceLastFrame, hopSize - 1);
+    }
 
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
+    int getHopSize() const { return hopSize; }
+
+    // message thread
+    // hands the analysis to the workers, visible editors go first and
+    // if nobody got to it by deadlineMs it is skipped
+    void submit(juce::Rectangle<float> fftBounds, double sampleRate, bool visible, double deadlineMs);
+    // takes the newest path the workers finished, if there is one
+    void pullLatestPath();
     juce::Path getPath() { return leftChannelFFTPath; }
+
+    // forgets everything from before the analyser was switched off,
+    // including what the audio thread left in the fifo
+    void reset();
 private:
+    juce::SharedResourcePointer<AnalyserWorkerPool> analyserPool;
+
+    // what the last submit asked for, the worker takes a copy
+    juce::SpinLock requestLock;
+    juce::Rectangle<float> requestedBounds;
+    double requestedSampleRate = 0.0;
+
+    void runAnalysis() override;
+    void process(juce::Rectangle<float> fftBounds, double sampleRate);
+
     SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>* leftChannelFifo;
 
+    // circular, writePosition is where the next sample goes
+    // and so also where the oldest one is
     juce::AudioBuffer<float> monoBuffer;
+    int writePosition = 0;
+
+    int hopSize = 0;
+    int samplesSinceLastFrame = 0;
 
     FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
 
     AnalyserPathGenerator<juce::Path> pathProducer;
 
     juce::Path leftChannelFFTPath;
+
+    // reads up to numSamples from the fifo into the circular buffer
+    void readIntoMonoBuffer(int numSamples);
 };
 
 
@@ -106,10 +162,10 @@ struct ResponseCurveComponent : juce::Component
     void paint(juce::Graphics&) override;
     void resized() override;
 
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
+    // while the analysis is switched on and the component is on screen the
+    // processor feeds the analyser fifos, the rest of the time it doesn't bother
+    void toggleAnalysisEnablement(bool enabled);
+    void visibilityChanged() override;
 private:
     SimpleEQAudioProcessor& audioProcessor;
     juce::Atomic<bool> parametersChanged{ false };
@@ -126,12 +182,53 @@ private:
 
     PathProducer leftPathProducer, rightPathProducer;
 
-    bool shouldShowFFTAnalysis = true;
+    bool shouldShowFFTAnalysis = false;
+    // registered with the processor as one of its analyser consumers
+    bool consumingAnalyser = false;
+
+    void updateAnalyserConsumer();
     
 
 };
 
 
+// p50, p99 and the worst block load plus how many blocks went over budget,
+// and the memory the shared coefficient tables take.
+// it only asks the processor while it is showing, hidden it has no timer running
+struct CpuLoadOverlay : juce::Component
+    , juce::Timer
+{
+    CpuLoadOverlay(SimpleEQAudioProcessor& p) : audioProcessor(p) { }
+
+    void timerCallback() override;
+    void paint(juce::Graphics& g) override;
+    void visibilityChanged() override;
+private:
+    SimpleEQAudioProcessor& audioProcessor;
+    BlockLoadMeter::Statistics statistics;
+    size_t tableBytes = 0;
+};
+
+
+// says so when the host runs us in double and a float only mode that is
+// switched on falls back to the biquad cascade. it is empty the rest of the time
+struct PrecisionFallbackNotice : juce::Component
+    , juce::Timer
+{
+    PrecisionFallbackNotice(SimpleEQAudioProcessor& p) : audioProcessor(p)
+    {
+        setInterceptsMouseClicks(false, false);
+        startTimerHz(2);
+    }
+
+    void timerCallback() override;
+    void paint(juce::Graphics& g) override;
+private:
+    SimpleEQAudioProcessor& audioProcessor;
+    juce::String text;
+};
+
+
 struct PowerButton : juce::ToggleButton { };
 struct AnalyserButton : juce::ToggleButton 
 {
@@ -193,6 +290,12 @@ private:
 
     ResponseCurveComponent responseCurveComponent;
 
+    // not a parameter, it is only there to find the expensive instances
+    juce::TextButton cpuLoadButton{ "CPU" };
+    CpuLoadOverlay cpuLoadOverlay;
+
+    PrecisionFallbackNotice precisionFallbackNotice;
+
     using APVTS = juce::AudioProcessorValueTreeState;
     using Attachment = APVTS::SliderAttachment;
 
@@ -26,6 +26,7 @@ SimpleEQAudioProcessor::SimpleEQAudioProcessor()
 
 SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -63,7 +64,9 @@ bool SimpleEQAudioProcessor::isMidiEffect() const
 
 double SimpleEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // worked out from the pole radii of the active stages every time
+    // the coefficients are designed (see computeTailSamples)
+    return coefficientService.getTailLengthSeconds();
 }
 
 int SimpleEQAudioProcessor::getNumPrograms()
@@ -96,20 +99,60 @@ void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
 
-    juce::dsp::ProcessSpec spec;
+    cascade.reset();
+    preciseCascade.reset();
+    svfCascade.prepare(sampleRate);
+    smoother.prepare(sampleRate, smoothingTimeSeconds);
 
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
-    spec.sampleRate = sampleRate;
+    coefficientTables = CoefficientTables::getFor(sampleRate);
+    coefficientTableBytes.store(coefficientTables->getMemorySizeBytes());
 
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    // the host picks the precision before it prepares us
+    processingDoubles = isUsingDoublePrecision();
+    usingMixedPrecision = mixedPrecision->load() > 0.5f;
+
+    auto numBufferChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    preciseBuffer.setSize(numBufferChannels, samplesPerBlock);
+    analyserBuffer.setSize(juce::jmin(numBufferChannels, 2), samplesPerBlock);
+
+    // this designs the first set synchronously
+    coefficientService.prepare(sampleRate);
 
     updateFilters(); // i missed that idk when it seemed to work fine thought
 
+    // the ramps start from what the filters are doing now
+    if (currentCoefficients != nullptr)
+        smoother.jumpTo(currentCoefficients->settings);
+
+    usingSvf = filterTopology->load() > 0.5f;
+    svfVersions = {};
+    updateSvfBands(0);
+
+    samplesUntilControlTick = 0;
+    samplesOfSilence = 0;
+    filtersAsleep = false;
+
+    neutralPath = false;
+    crossfadeLength = juce::roundToInt(sampleRate * crossfadeSeconds);
+    crossfadeSamplesRemaining = 0;
+    crossfadeBuffer.setSize(numBufferChannels, crossfadeLength);
+    preciseCrossfadeBuffer.setSize(numBufferChannels, crossfadeLength);
+
+    // after the coefficientService so the first kernel is built from the new design.
+    // the convolver drops its kernel and the designer won't hand out one from the
+    // old rate, so the iir cascade plays until a kernel for this rate arrives
+    linearPhaseDesigner.prepare(sampleRate);
+    linearPhaseConvolver.prepare(numBufferChannels,
+        linearPhaseDesigner.getFirLength() / PartitionedConvolver::partitionSize);
+
+    linearPhaseActive = false;
+    setLatencySamples(0);
+
     leftChannelFifo.prepare(samplesPerBlock);
     rightChannelFifo.prepare(samplesPerBlock);
 
+    loadMeter.prepare(sampleRate);
+
     // osc
     //osc.initialise([](float x) {return std::sin(x); });
 
@@ -132,11 +175,11 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     return true;
   #else
     // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // the cascade packs any number of channels into simd lanes so everything
+    // from mono to 7.1.4 and ambisonics works, up to CascadeEngine::maxChannels
+    auto outputChannels = layouts.getMainOutputChannelSet();
+
+    if (outputChannels.isDisabled() || outputChannels.size() > CascadeEngine::maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -152,6 +195,28 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 
 void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // a 64 bit host hands us its buffers as they are
+    // instead of converting them to float and back for every instance
+    juce::ignoreUnused(midiMessages);
+    processSamples(buffer);
+}
+
+bool SimpleEQAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template<typename SampleType>
+void SimpleEQAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    BlockLoadMeter::ScopedBlockTimer blockTimer{ loadMeter, buffer.getNumSamples() };
+    RealtimeSafety::ScopedRealtimeSection realtimeSection;
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -166,37 +231,124 @@ void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
         buffer.clear (i, 0, buffer.getNumSamples());
 
 
-    updateFilters();
+    pickUpParameterChanges();
+
+    setSmoothing(smoothAutomation->load() > 0.5f);
+    updatePrecision(std::is_same<SampleType, double>::value);
+
+    // the float only modes, switched on in a double block
+    constexpr auto isDouble = std::is_same<SampleType, double>::value;
+    linearPhaseFallback.store(isDouble && linearPhaseMode->load() > 0.5f);
+    filterTopologyFallback.store(isDouble && filterTopology->load() > 0.5f);
 
 
 
 
-    // First we crate an audioBlock which grabs this buffer
-    juce::dsp::AudioBlock<float> block(buffer);
-    
     // osc
     //buffer.clear();
     //juce::dsp::ProcessContextReplacing<float> stereoContext(block);
     //osc.process(stereoContext);
 
-    // Then we can use the helper function to extract the 2 channels individually
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    // every channel runs through the same cascade
+    // packed into the lanes of simd registers
+    auto numChannels = juce::jmin(totalNumInputChannels, buffer.getNumChannels(), CascadeEngine::maxChannels);
 
-    // create processing contexts for each channel
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    // the linear phase mode only runs in float
+    if constexpr (std::is_same<SampleType, float>::value)
+    {
+        if (updateLinearPhase())
+        {
+            // the iir coefficients keep following the parameters
+            // so switching back picks up the current settings
+            updateSleepingFilters();
+            linearPhaseConvolver.process(buffer.getArrayOfWritePointers(), numChannels, buffer.getNumSamples());
+
+            pushToAnalyser(buffer);
+            return;
+        }
+    }
+
+    updateNeutralPath();
+
+    if (neutralPath && crossfadeSamplesRemaining == 0)
+    {
+        // the settings don't change the sound, the input goes straight through
+        fastPathBlocks.fetch_add(1);
+        updateSleepingFilters();
+    }
+    else
+    {
+        // the start of the block is still inside a crossfade
+        // so keep the dry signal to mix it back in afterwards
+        auto numCrossfadeSamples = juce::jmin(crossfadeSamplesRemaining, buffer.getNumSamples());
+        auto& dryBuffer = getCrossfadeBuffer(buffer);
 
-    // pass the audio context to each channel filter chain for processing
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+        for (int ch = 0; ch < numChannels && numCrossfadeSamples > 0; ++ch)
+            dryBuffer.copyFrom(ch, 0, buffer, ch, 0, numCrossfadeSamples);
 
+        processFilters(buffer, numChannels);
+
+        if (numCrossfadeSamples > 0)
+            applyCrossfade(buffer, dryBuffer, numChannels, numCrossfadeSamples);
+    }
+
+
+    pushToAnalyser(buffer);
+
+}
+
+juce::AudioBuffer<float>& SimpleEQAudioProcessor::getCrossfadeBuffer(const juce::AudioBuffer<float>&)
+{
+    return crossfadeBuffer;
+}
+
+juce::AudioBuffer<double>& SimpleEQAudioProcessor::getCrossfadeBuffer(const juce::AudioBuffer<double>&)
+{
+    return preciseCrossfadeBuffer;
+}
+
+void SimpleEQAudioProcessor::pushToAnalyser(const juce::AudioBuffer<float>& buffer)
+{
+    // nobody is looking, whoever starts looking clears out what is left in the fifos
+    if (analyserConsumers.load() == 0)
+        return;
 
     leftChannelFifo.update(buffer);
     rightChannelFifo.update(buffer);
-
 }
 
+void SimpleEQAudioProcessor::pushToAnalyser(const juce::AudioBuffer<double>& buffer)
+{
+    if (analyserConsumers.load() == 0)
+        return;
+
+    // the analyser works in float, the block goes over in pieces
+    // as long as the buffer that got allocated in prepareToPlay
+    auto numChannels = juce::jmin(buffer.getNumChannels(), analyserBuffer.getNumChannels());
+    auto capacity = analyserBuffer.getNumSamples();
+
+    if (numChannels == 0 || capacity == 0)
+        return;
+
+    for (int position = 0; position < buffer.getNumSamples(); position += capacity)
+    {
+        auto numSamples = juce::jmin(capacity, buffer.getNumSamples() - position);
+
+        juce::AudioBuffer<float> piece(analyserBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* source = buffer.getReadPointer(ch, position);
+            auto* destination = piece.getWritePointer(ch);
+
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = static_cast<float>(source[i]);
+        }
+
+        leftChannelFifo.update(piece);
+        rightChannelFifo.update(piece);
+    }
+}
 
 //==============================================================================
 bool SimpleEQAudioProcessor::hasEditor() const
@@ -230,113 +382,617 @@ void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBy
     if (tree.isValid())
     {
         apvts.replaceState(tree);
-        updateFilters();
+        // the audio thread picks this up on the next block
+        coefficientService.designNow();
     }
 
 }
 
+ChainParameters::ChainParameters(juce::AudioProcessorValueTreeState& apvts) :
+    lowCutFreq(apvts.getRawParameterValue("LowCut Freq")),
+    highCutFreq(apvts.getRawParameterValue("HighCut Freq")),
+    peakFreq(apvts.getRawParameterValue("Peak Freq")),
+    peakGainInDecibells(apvts.getRawParameterValue("Peak Gain")),
+    peakQ(apvts.getRawParameterValue("Peak Q")),
+    lowCutSlope(apvts.getRawParameterValue("LowCut Slope")),
+    highCutSlope(apvts.getRawParameterValue("HighCut Slope")),
+    lowCutBypassed(apvts.getRawParameterValue("LowCut Bypassed")),
+    peakBypassed(apvts.getRawParameterValue("Peak Bypassed")),
+    highCutBypassed(apvts.getRawParameterValue("HighCut Bypassed"))
+{
+}
+
 ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+{
+    return getChainSettings(ChainParameters(apvts));
+}
+
+ChainSettings getChainSettings(const ChainParameters& parameters)
 {
     ChainSettings settings;
 
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibells = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQ = apvts.getRawParameterValue("Peak Q")->load();
+    settings.lowCutFreq = parameters.lowCutFreq->load();
+    settings.highCutFreq = parameters.highCutFreq->load();
+    settings.peakFreq = parameters.peakFreq->load();
+    settings.peakGainInDecibells = parameters.peakGainInDecibells->load();
+    settings.peakQ = parameters.peakQ->load();
     // when we changed the slope from int to Slope type we got a compiller error
     // we need to static_cast<Slope> the values before we assign them to correct it
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
+    settings.lowCutSlope = static_cast<Slope>(parameters.lowCutSlope->load());
+    settings.highCutSlope = static_cast<Slope>(parameters.highCutSlope->load());
 
     // these are boolean parameters but they are stored as floats
     // so if the vlaue is greater than 0.5 then its true
 
-    settings.lowCutBypassed = apvts.getRawParameterValue("LowCut Bypassed")->load() > 0.5f;
-    settings.peakBypassed = apvts.getRawParameterValue("Peak Bypassed")->load() > 0.5f;
-    settings.highCutBypassed = apvts.getRawParameterValue("HighCut Bypassed")->load() > 0.5f;
+    settings.lowCutBypassed = parameters.lowCutBypassed->load() > 0.5f;
+    settings.peakBypassed = parameters.peakBypassed->load() > 0.5f;
+    settings.highCutBypassed = parameters.highCutBypassed->load() > 0.5f;
 
 
     return settings;
 }
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+void SimpleEQAudioProcessor::updatePeakFilter(const CoefficientSet& coefficients, int rampSamples)
 {
-    // calculate coefficients using the juce helper funcions
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-        chainSettings.peakFreq,
-        chainSettings.peakQ,
-        juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibells));
+    // the coefficients were designed by the coefficientService
+    // we only copy the values into the cascade so there
+    // is no heap allocation on the audio thread anymore
+    applyBandToCascades(coefficients, Peak, rampSamples);
 }
 
+void SimpleEQAudioProcessor::updateLowCutFilter(const CoefficientSet& coefficients, int rampSamples)
+{
+    // the slope is expressed by which of the 4 sections are active
+    applyBandToCascades(coefficients, LowCut, rampSamples);
+}
 
-void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
+void SimpleEQAudioProcessor::updateHighCutFilter(const CoefficientSet& coefficients, int rampSamples)
 {
-    
-    auto peakCoeficients = makePeakFilter(chainSettings, getSampleRate());
+    applyBandToCascades(coefficients, HighCut, rampSamples);
+}
 
-    // the coefficients object is a reference-counted wrapper around an array
-    // that is allocated on the heap
-    // we need to copy its values over so we need to dereference it
-    // !!!allocating on the heap on an audio callback is bad!!!!
-    // but we are gonna ignore that design flaw for now
+void SimpleEQAudioProcessor::applyBandToCascades(const CoefficientSet& coefficients, ChainPossitions band, int rampSamples)
+{
+    // a band only moves between the float and the double cascade when it jumps,
+    // a ramp always finishes in the cascade it started in
+    if (rampSamples == 0)
+        preciseBands[band] = shouldBePrecise(coefficients, band);
+
+    auto precise = preciseBands[band];
 
-    leftChain.setBypassed<ChainPossitions::Peak>(chainSettings.peakBypassed);
-    rightChain.setBypassed<ChainPossitions::Peak>(chainSettings.peakBypassed);
+    // the band is switched off in the cascade that doesn't run it
+    if (rampSamples > 0)
+    {
+        cascade.rampBand(coefficients, band, rampSamples, !precise);
+        preciseCascade.rampBand(coefficients, band, rampSamples, precise);
+    }
+    else
+    {
+        cascade.setBand(coefficients, band, !precise);
+        preciseCascade.setBand(coefficients, band, precise);
+    }
+}
 
+bool SimpleEQAudioProcessor::shouldBePrecise(const CoefficientSet& coefficients, ChainPossitions band) const
+{
+    if (processingDoubles)
+        return true;
 
-    updateCoefficients(leftChain.get<ChainPossitions::Peak>().coefficients, peakCoeficients);
-    updateCoefficients(rightChain.get<ChainPossitions::Peak>().coefficients, peakCoeficients);
+    if (!usingMixedPrecision)
+        return false;
 
+    const auto& settings = coefficients.settings;
+    auto frequency = band == LowCut ? settings.lowCutFreq : band == Peak ? settings.peakFreq : settings.highCutFreq;
 
+    return frequency < coefficients.sampleRate * precisionFrequencyRatio;
 }
 
-void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+void SimpleEQAudioProcessor::updatePrecision(bool blockIsDouble)
 {
-    *old = *replacements;
+    auto shouldUseMixedPrecision = mixedPrecision->load() > 0.5f;
+
+    if (blockIsDouble == processingDoubles && shouldUseMixedPrecision == usingMixedPrecision)
+        return;
+
+    processingDoubles = blockIsDouble;
+    usingMixedPrecision = shouldUseMixedPrecision;
+
+    // every band jumps into the cascade it belongs to now, the moved bands start from silence
+    resetFilterState();
+    applyAllBands();
+}
+
+void SimpleEQAudioProcessor::updateBand(const CoefficientSet& coefficients, ChainPossitions band, int rampSamples)
+{
+    switch (band)
+    {
+    case LowCut:
+        updateLowCutFilter(coefficients, rampSamples);
+        break;
+    case Peak:
+        updatePeakFilter(coefficients, rampSamples);
+        break;
+    case HighCut:
+        updateHighCutFilter(coefficients, rampSamples);
+        break;
+    }
+}
+
+void SimpleEQAudioProcessor::pickUpParameterChanges()
+{
+    // whatever the design thread published since the last block,
+    // everything from here on (the neutral path, the tail, the filters) sees it.
+    // the filters look again at every cut of the block (see forEachControlSegment)
+    if (auto* latest = coefficientService.pullLatest())
+        currentCoefficients = latest;
+}
+
+void SimpleEQAudioProcessor::updateFilters()
+{
+    // the designing happens on the coefficientService's thread
+    // here we only pick up a new set when one was published
+    // most of the time nothing changed and this is a single atomic load
+    if (auto* latest = coefficientService.pullLatest())
+        currentCoefficients = latest;
+
+    if (currentCoefficients == nullptr)
+        return;
+
+    // only the bands whose version moved need their coefficients copied
+    for (int band = 0; band < CoefficientSet::numBands; ++band)
+    {
+        if (currentCoefficients->versions[band] != appliedVersions[band])
+            updateBand(*currentCoefficients, static_cast<ChainPossitions>(band));
+    }
+
+    appliedVersions = currentCoefficients->versions;
 }
 
-void SimpleEQAudioProcessor::updateLowCutFilter(const ChainSettings& chainSettings)
+void SimpleEQAudioProcessor::updateSmoothedFilters()
 {
+    if (auto* latest = coefficientService.pullLatest())
+        currentCoefficients = latest;
+
+    if (currentCoefficients == nullptr)
+        return;
+
+    const auto& target = *currentCoefficients;
+
+    // a new set only moves the targets of the ramps
+    for (int band = 0; band < CoefficientSet::numBands; ++band)
+    {
+        if (target.versions[band] == appliedVersions[band])
+            continue;
+
+        auto position = static_cast<ChainPossitions>(band);
+
+        if (smoother.canGlideTo(target.settings, position))
+        {
+            smoother.setTarget(target.settings, position);
+        }
+        else
+        {
+            // slope and bypass changes can't glide so they jump like before
+            smoother.jumpTo(target.settings, position);
+            updateBand(target, position);
+        }
+    }
+
+    appliedVersions = target.versions;
 
-    // this function will return an array with one coefficient object for every 2 filter orders
-    // thus we need to provide it with 2, 4, 6, 8 for our 12, 24 ,36 ,48 db/Oct slopes
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
+    auto moved = smoother.advance(controlInterval);
 
+    auto useTables = useCoefficientTables->load() > 0.5f && coefficientTables != nullptr;
 
-    auto& leftLowCut = leftChain.get<ChainPossitions::LowCut>();
-    auto& rightLowCut = rightChain.get<ChainPossitions::LowCut>();
+    // the bands that are ramping get designed for where the ramp is at the end
+    // of this control interval and the cascade glides there sample by sample.
+    // both ways of designing write straight into smoothedCoefficients
+    // so nothing here allocates or locks
+    for (int band = 0; band < CoefficientSet::numBands; ++band)
+    {
+        if (!moved[band])
+            continue;
+
+        auto position = static_cast<ChainPossitions>(band);
 
-    leftChain.setBypassed<ChainPossitions::LowCut>(chainSettings.lowCutBypassed);
-    rightChain.setBypassed<ChainPossitions::LowCut>(chainSettings.lowCutBypassed);
+        // the last step of a ramp lands on the published design itself
+        // so a glided band ends up exactly where a jump would have put it
+        if (!smoother.isSmoothing(position))
+        {
+            updateBand(target, position, controlInterval);
+            continue;
+        }
 
-    updateCutFilter(leftLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+        if (useTables)
+            designBand(smoothedCoefficients, position, smoother.getCurrentSettings(), *coefficientTables);
+        else
+            designBand(smoothedCoefficients, position, smoother.getCurrentSettings(), target.sampleRate);
 
+        // the tables are float, a band in the double cascade is designed in double
+        if (preciseBands[band])
+            designPreciseBand(smoothedCoefficients, position, smoother.getCurrentSettings(), target.sampleRate);
+
+        updateBand(smoothedCoefficients, position, controlInterval);
+    }
 }
 
-void SimpleEQAudioProcessor::updateHighCutFilter(const ChainSettings& chainSettings)
+void SimpleEQAudioProcessor::setSmoothing(bool shouldSmooth)
 {
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
+    if (shouldSmooth == wasSmoothing)
+        return;
 
-    auto& leftHighCut = leftChain.get<ChainPossitions::HighCut>();
-    auto& rightHighCut = rightChain.get<ChainPossitions::HighCut>();
+    wasSmoothing = shouldSmooth;
 
-    leftChain.setBypassed<ChainPossitions::HighCut>(chainSettings.highCutBypassed);
-    rightChain.setBypassed<ChainPossitions::HighCut>(chainSettings.highCutBypassed);
-    
+    if (currentCoefficients == nullptr)
+        return;
 
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    if (shouldSmooth)
+    {
+        // start the ramps from what is playing and design on the next sample
+        smoother.jumpTo(currentCoefficients->settings);
+        samplesUntilControlTick = 0;
+    }
+    else
+    {
+        // drop whatever ramp is running and go straight to the latest design
+        applyAllBands();
+    }
 }
 
-void SimpleEQAudioProcessor::updateFilters()
+void SimpleEQAudioProcessor::applyAllBands()
+{
+    if (currentCoefficients == nullptr)
+        return;
+
+    for (int band = 0; band < CoefficientSet::numBands; ++band)
+        updateBand(*currentCoefficients, static_cast<ChainPossitions>(band));
+
+    appliedVersions = currentCoefficients->versions;
+}
+
+template<typename SampleType>
+bool SimpleEQAudioProcessor::canSkipFilters(const juce::AudioBuffer<SampleType>& buffer, int numChannels)
+{
+    auto numSamples = buffer.getNumSamples();
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (buffer.getMagnitude(ch, 0, numSamples) > static_cast<SampleType>(silenceThreshold))
+        {
+            samplesOfSilence = 0;
+            filtersAsleep = false;
+            return false;
+        }
+    }
+
+    if (filtersAsleep)
+        return true;
+
+    // the input has been silent for samplesOfSilence samples before this block.
+    // once that is longer than the tail the state has decayed below the threshold
+    auto tailSamples = currentCoefficients != nullptr ? currentCoefficients->tailSamples : 0;
+
+    if (samplesOfSilence >= tailSamples)
+    {
+        // land any running ramp on its design and clear what is left of the state
+        // so the filters wake up from exactly zero
+        applyAllBands();
+        resetFilterState();
+
+        filtersAsleep = true;
+        return true;
+    }
+
+    samplesOfSilence = juce::jmin(samplesOfSilence + numSamples, std::numeric_limits<int>::max() - numSamples);
+    return false;
+}
+
+template<typename SampleType, typename TickFunction, typename SegmentFunction>
+void SimpleEQAudioProcessor::forEachControlSegment(juce::AudioBuffer<SampleType>& buffer, int numChannels,
+    TickFunction&& onTick, SegmentFunction&& processSegment)
+{
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    auto numSamples = buffer.getNumSamples();
+
+    std::array<SampleType*, CascadeEngine::maxChannels> segment;
+    int numCuts = 0;
+
+    // whatever is there already plays from the first sample
+    onTick();
+
+    for (int position = 0; position < numSamples;)
+    {
+        if (samplesUntilControlTick == 0)
+        {
+            if (position > 0)
+            {
+                onTick();
+                ++numCuts;
+            }
+
+            samplesUntilControlTick = controlInterval;
+        }
+
+        // out of cuts, the rest of the block goes in one piece
+        auto numSegmentSamples = numCuts < maxControlCutsPerBlock
+            ? juce::jmin(samplesUntilControlTick, numSamples - position)
+            : numSamples - position;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            segment[ch] = channels[ch] + position;
+
+        processSegment(segment.data(), numSegmentSamples);
+
+        position += numSegmentSamples;
+
+        // the grid stays where it was however long that piece was
+        samplesUntilControlTick = ((samplesUntilControlTick - numSegmentSamples) % controlInterval + controlInterval) % controlInterval;
+    }
+}
+
+template<typename SampleType>
+void SimpleEQAudioProcessor::processFilters(juce::AudioBuffer<SampleType>& buffer, int numChannels)
 {
-    auto chainSettings = getChainSettings(apvts);
+    // the state variable engine only runs in float
+    constexpr auto isFloat = std::is_same<SampleType, float>::value;
+
+    if constexpr (isFloat)
+        updateTopology();
+
+    if (canSkipFilters(buffer, numChannels))
+    {
+        // silent input and a silent cascade, the buffer is already the output
+        updateSleepingFilters();
+        return;
+    }
 
-    updateLowCutFilter(chainSettings);
-    updatePeakFilter(chainSettings);
-    updateHighCutFilter(chainSettings);
+    if constexpr (isFloat)
+    {
+        if (usingSvf)
+        {
+            processSvf(buffer, numChannels);
+            return;
+        }
+    }
+
+    if (wasSmoothing)
+    {
+        processSmoothed(buffer, numChannels);
+    }
+    else
+    {
+        // a set published while the block runs jumps in at the next cut
+        forEachControlSegment(buffer, numChannels,
+            [this] { updateFilters(); },
+            [this, numChannels](SampleType* const* channels, int numSamples) { runCascades(channels, numChannels, numSamples); });
+    }
+}
+
+void SimpleEQAudioProcessor::runCascades(float* const* channels, int numChannels, int numSamples)
+{
+    cascade.process(channels, numChannels, numSamples);
+
+    if (!preciseCascade.hasActiveStages())
+        return;
+
+    // mixed precision: the low frequency bands go through the double cascade,
+    // the block goes over in pieces as long as the buffer from prepareToPlay.
+    // the bands are all linear so running them in two batches is the same chain
+    auto capacity = preciseBuffer.getNumSamples();
+    auto* const* precise = preciseBuffer.getArrayOfWritePointers();
+
+    for (int position = 0; position < numSamples; position += capacity)
+    {
+        auto numPieceSamples = juce::jmin(capacity, numSamples - position);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < numPieceSamples; ++i)
+                precise[ch][i] = static_cast<double>(channels[ch][position + i]);
+        }
+
+        preciseCascade.process(precise, numChannels, numPieceSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < numPieceSamples; ++i)
+                channels[ch][position + i] = static_cast<float>(precise[ch][i]);
+        }
+    }
+}
+
+void SimpleEQAudioProcessor::runCascades(double* const* channels, int numChannels, int numSamples)
+{
+    // with double buffers every band runs in the double cascade
+    jassert(!cascade.hasActiveStages());
+    preciseCascade.process(channels, numChannels, numSamples);
+}
+
+bool SimpleEQAudioProcessor::updateLinearPhase()
+{
+    if (auto* kernel = linearPhaseDesigner.pullLatest())
+        linearPhaseConvolver.setKernel(kernel);
+
+    // until the first kernel arrives the iir cascade carries on
+    auto shouldBeActive = linearPhaseMode->load() > 0.5f && linearPhaseConvolver.hasKernel();
+
+    if (shouldBeActive != linearPhaseActive.load())
+    {
+        linearPhaseActive = shouldBeActive;
+
+        // whichever path takes over starts from silence
+        if (shouldBeActive)
+            linearPhaseConvolver.reset();
+        else
+            resetFilterState();
+
+        // the latency changed, the host gets told on the message thread.
+        // posting the message takes the message queue's lock, that only
+        // happens when the mode gets switched
+        RealtimeSafety::ScopedAllowance allowance("posting the latency change");
+        triggerAsyncUpdate();
+    }
+
+    return shouldBeActive;
+}
+
+void SimpleEQAudioProcessor::updateTopology()
+{
+    auto shouldUseSvf = filterTopology->load() > 0.5f;
+
+    if (shouldUseSvf == usingSvf)
+        return;
+
+    usingSvf = shouldUseSvf;
+
+    // the other topology stood still while this one was playing
+    // so it starts from silence on the current settings
+    resetFilterState();
+
+    if (usingSvf)
+    {
+        svfVersions = {};
+        updateSvfBands(0);
+    }
+    else
+    {
+        applyAllBands();
+
+        if (currentCoefficients != nullptr)
+            smoother.jumpTo(currentCoefficients->settings);
+    }
+}
+
+void SimpleEQAudioProcessor::updateSvfBands(int glideSamples)
+{
+    if (currentCoefficients == nullptr)
+        return;
+
+    // the sections are designed from the settings, the biquads in the set aren't needed
+    for (int band = 0; band < CoefficientSet::numBands; ++band)
+    {
+        if (currentCoefficients->versions[band] != svfVersions[band])
+            svfCascade.glideBand(currentCoefficients->settings, static_cast<ChainPossitions>(band), glideSamples);
+    }
+
+    svfVersions = currentCoefficients->versions;
+}
+
+void SimpleEQAudioProcessor::processSvf(juce::AudioBuffer<float>& buffer, int numChannels)
+{
+    forEachControlSegment(buffer, numChannels,
+        [this]
+        {
+            if (auto* latest = coefficientService.pullLatest())
+                currentCoefficients = latest;
+
+            // with smoothing the bands glide sample by sample, without it they jump
+            auto glideSamples = wasSmoothing && currentCoefficients != nullptr
+                ? juce::roundToInt(currentCoefficients->sampleRate * smoothingTimeSeconds)
+                : 0;
+
+            updateSvfBands(glideSamples);
+        },
+        [this, numChannels](float* const* channels, int numSamples) { svfCascade.process(channels, numChannels, numSamples); });
+}
+
+void SimpleEQAudioProcessor::resetFilterState()
+{
+    cascade.reset();
+    preciseCascade.reset();
+    svfCascade.reset();
+}
+
+void SimpleEQAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(getProcessingLatencySamples());
+}
+
+void SimpleEQAudioProcessor::updateNeutralPath()
+{
+    auto shouldBeNeutral = currentCoefficients != nullptr && currentCoefficients->neutral;
+
+    if (shouldBeNeutral == neutralPath)
+        return;
+
+    neutralPath = shouldBeNeutral;
+
+    // if the crossfade the other way is still running
+    // this turns it around from where it got to
+    crossfadeSamplesRemaining = crossfadeLength - crossfadeSamplesRemaining;
+}
+
+template<typename SampleType>
+void SimpleEQAudioProcessor::applyCrossfade(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& dryBuffer, int numChannels, int numSamples)
+{
+    auto position = crossfadeLength - crossfadeSamplesRemaining;
+    auto step = 1.f / static_cast<float>(crossfadeLength);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* wet = buffer.getWritePointer(ch);
+        auto* dry = dryBuffer.getReadPointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto progress = static_cast<float>(position + i + 1) * step;
+
+            // going into the fast path fades the filters out, coming back fades them in
+            auto wetGain = neutralPath ? 1.f - progress : progress;
+
+            wet[i] = dry[i] + (wet[i] - dry[i]) * wetGain;
+        }
+    }
+
+    crossfadeSamplesRemaining -= numSamples;
+
+    // the cascade won't run for a while, start it from silence when it comes back
+    if (neutralPath && crossfadeSamplesRemaining == 0)
+        resetFilterState();
+}
+
+void SimpleEQAudioProcessor::updateSleepingFilters()
+{
+    // the coefficients still follow the parameters while asleep (or on the fast path),
+    // there is nothing to hear so every change can jump straight to its target
+    updateFilters();
+
+    if (currentCoefficients != nullptr)
+        smoother.jumpTo(currentCoefficients->settings);
+
+    updateSvfBands(0);
+
+    samplesUntilControlTick = 0;
+}
+
+template<typename SampleType>
+void SimpleEQAudioProcessor::processSmoothed(juce::AudioBuffer<SampleType>& buffer, int numChannels)
+{
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    auto numSamples = buffer.getNumSamples();
+
+    std::array<SampleType*, CascadeEngine::maxChannels> segment;
+
+    // the block is cut on a fixed grid of controlInterval samples that carries on
+    // across blocks, so the ramps sound the same whatever the host's block size is
+    for (int position = 0; position < numSamples;)
+    {
+        if (samplesUntilControlTick == 0)
+        {
+            updateSmoothedFilters();
+            samplesUntilControlTick = controlInterval;
+        }
+
+        auto numSegmentSamples = juce::jmin(samplesUntilControlTick, numSamples - position);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            segment[ch] = channels[ch] + position;
+
+        runCascades(segment.data(), numChannels, numSegmentSamples);
+
+        position += numSegmentSamples;
+        samplesUntilControlTick -= numSegmentSamples;
+    }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::createParameterLayout()
@@ -403,6 +1059,33 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::crea
     layout.add(std::make_unique<juce::AudioParameterBool>("Analyser Enabled",
         "Analyser Enabled",
         true));
+
+    // glides the filters to automated values at a fixed control rate
+    layout.add(std::make_unique<juce::AudioParameterBool>("Smooth Automation",
+        "Smooth Automation",
+        false));
+
+    // the smoothed automation fetches its designs from lookup tables
+    layout.add(std::make_unique<juce::AudioParameterBool>("Coefficient Tables",
+        "Coefficient Tables",
+        false));
+
+    // the same curve with linear phase, at the cost of latency.
+    // float only, a 64 bit host gets the biquad cascade (the editor says so)
+    layout.add(std::make_unique<juce::AudioParameterBool>("Linear Phase",
+        "Linear Phase",
+        false));
+
+    // state variable sections can be modulated every sample, the static curve is the same.
+    // float only like the linear phase mode
+    layout.add(std::make_unique<juce::AudioParameterChoice>("Filter Topology",
+        "Filter Topology",
+        juce::StringArray{ "Biquad", "State Variable" }, 0));
+
+    // runs the low frequency bands in double precision even when the host sends floats
+    layout.add(std::make_unique<juce::AudioParameterBool>("Mixed Precision",
+        "Mixed Precision",
+        false));
     
     
 
@@ -14,102 +14,22 @@
 #include "Slope.h"
 #include "ChainPossitions.h"
 #include "ChainSettings.h"
+#include "FilterDesign.h"
+#include "CoefficientService.h"
+#include "CascadeEngine.h"
+#include "ChainSmoother.h"
+#include "CoefficientTables.h"
+#include "LinearPhaseDesigner.h"
+#include "SvfEngine.h"
+#include "RealtimeSafety.h"
+#include "BlockLoadMeter.h"
 
 
-// function that return the parameters in a ChainSettings struct
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
-    
-// Create namespace aliases
-// this is a generic IIR filter class that can be used to represent 
-// a single cut or peak filter
-using Filter = juce::dsp::IIR::Filter<float>;
-
-// the default juce IIR cut filters slope is 12 db/Oct 
-// so we need 4 to acheive 48 db/Oct slope
-// we will use the same processor chain for both cut filters 
-// since they have the same architecture
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
-
-// this helper function is used to update coefficients
-// we make an alias to the type juce uses for the coeffs 
-using Coefficients = Filter::CoefficientsPtr;
-
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
-
-
-template<int Index, typename ChainType, typename CoefficientType>
-void update(ChainType& chain, CoefficientType& coefficients)
-{
-    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-    chain.template setBypassed<Index>(false);
-}
-
-
-
-// we are not sure what typenames to use 
-// for the parameters of our low cut update function 
-// so we use a templated function
-template<typename ChainType, typename CoefficientType>
-void updateCutFilter(ChainType& cut,
-    const CoefficientType& cutCoefficients,
-    const Slope& cutSlope)
-{
-
-    // compiles without the template keyword ??
-    cut.template setBypassed<0>(true);
-    cut.template setBypassed<1>(true);
-    cut.template setBypassed<2>(true);
-    cut.template setBypassed<3>(true);
-
-
-
-    // now for each setting we will assign the respective set of coeffs and unbypass it
-    // if we reverse the switch order we can leverage
-    // case passthrough to eliminate code duplication
-    // we dont break our switch statement
-    switch (cutSlope)
-    {
-    case Slope_48:
-        update<3>(cut, cutCoefficients);
-    case Slope_36:
-        update<2>(cut, cutCoefficients);
-    case Slope_24:
-        update<1>(cut, cutCoefficients);
-    case Slope_12:
-        update<0>(cut, cutCoefficients);
-    }
-
-}
-
-// if we want to implement theese functions 
-// in header files that are included in more
-// than one place we need to use the inline 
-// keyword otherwise the compiler will produce
-// a definition for this function everywhere
-// that this header file is included and the 
-// linker will not now which version to use
-
-inline auto makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-     return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
-         sampleRate,
-         (chainSettings.lowCutSlope + 1) * 2);
-}
-inline auto makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
-        sampleRate,
-        (chainSettings.highCutSlope + 1) * 2);
-}
-
 //==============================================================================
 /**
 */
-class SimpleEQAudioProcessor  : public juce::AudioProcessor
+class SimpleEQAudioProcessor  : public juce::AudioProcessor,
+                                private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -125,6 +45,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -158,20 +80,193 @@ public:
     SingleChannelSampleFifo<BlockType> leftChannelFifo{ Channel::Left };
     SingleChannelSampleFifo<BlockType> rightChannelFifo{ Channel::Right };
 
+    // the fifos above only get fed while something is reading them,
+    // every consumer adds itself while it shows the analysis and removes itself after
+    void addAnalyserConsumer() { analyserConsumers.fetch_add(1); }
+    void removeAnalyserConsumer() { analyserConsumers.fetch_sub(1); }
+
+    // how many blocks went straight through because the settings were neutral
+    juce::uint64 getNumFastPathBlocks() const { return fastPathBlocks.load(); }
+
+    // the delay of what processBlock is doing right now, unlike getLatencySamples()
+    // it doesn't wait for the message thread so offline renders can line the output up with it
+    int getProcessingLatencySamples() const { return linearPhaseActive.load() ? linearPhaseDesigner.getLatencySamples() : 0; }
+
+    // the linear phase mode and the state variable topology only run in float.
+    // with a 64 bit host they fall back to the double biquad cascade, these say
+    // whether that is happening right now so the editor can tell the user.
+    // safe to ask from any thread
+    bool isLinearPhaseFallingBack() const { return linearPhaseFallback.load(); }
+    bool isFilterTopologyFallingBack() const { return filterTopologyFallback.load(); }
+
+    // how much memory the lookup tables for the current sample rate take, 0 before prepareToPlay.
+    // every instance at that rate shares them, so they only count once
+    // safe to ask from any thread
+    size_t getCoefficientTableMemoryBytes() const { return coefficientTableBytes.load(); }
+
+    // how long the blocks took against their realtime budget since prepareToPlay,
+    // safe to ask from any thread
+    BlockLoadMeter::Statistics getBlockLoadStatistics() const { return loadMeter.getStatistics(); }
+
 
 
 
 private:
-    // declare the 2 channels for stereo processing
-    MonoChain leftChain, rightChain;
-        
+    // processes all the channels together, one per simd lane
+    CascadeEngine cascade;
+
+    // designs the coefficients off the audio thread
+    // needs to be declared after the apvts
+    CoefficientService coefficientService{ apvts };
+
+    // the band versions of the coefficients the chains are currently using
+    std::array<juce::uint32, CoefficientSet::numBands> appliedVersions{};
+
+    // the newest set we pulled, it stays valid until the next pull
+    const CoefficientSet* currentCoefficients = nullptr;
+
+    // smoothed automation
+    // the filters get redesigned every controlInterval samples from the
+    // smoother's ramps and the cascade glides between the designs, so the
+    // cost only depends on the number of samples and not on the block size
+    static constexpr int controlInterval = 32;
+
+    // without smoothing the block is cut on the same grid and every cut picks up
+    // a set the design thread published in the meantime. it is only a pull and
+    // copying the changed bands, nothing gets designed on the audio thread, and
+    // there are never more than maxControlCutsPerBlock cuts in a block
+    static constexpr int maxControlCutsPerBlock = 16;
+    static constexpr double smoothingTimeSeconds = 0.05;
+
+    std::atomic<float>* smoothAutomation{ apvts.getRawParameterValue("Smooth Automation") };
+    bool wasSmoothing = false;
+    int samplesUntilControlTick = 0;
+
+    ChainSmoother smoother;
+    CoefficientSet smoothedCoefficients;
+
+    // lookup tables for the control rate designs, shared with every
+    // other instance that runs at the same sample rate
+    std::atomic<float>* useCoefficientTables{ apvts.getRawParameterValue("Coefficient Tables") };
+    std::shared_ptr<const CoefficientTables> coefficientTables;
+    std::atomic<size_t> coefficientTableBytes{ 0 };
+
+
+    // silence detection
+    // once the input is silent and the tail of the filters has died away
+    // the cascade is put to sleep until something comes in again
+    static constexpr float silenceThreshold = 1.0e-6f; // -120 dB
+
+    int samplesOfSilence = 0;
+    bool filtersAsleep = false;
+
+
+    // neutral settings fast path
+    // when the settings can't be heard the cascade is skipped altogether,
+    // going in and out of that crossfades over crossfadeSeconds
+    static constexpr double crossfadeSeconds = 0.005;
+
+    bool neutralPath = false;
+    int crossfadeLength = 0;
+    int crossfadeSamplesRemaining = 0;
+    juce::AudioBuffer<float> crossfadeBuffer;
+
+    std::atomic<juce::uint64> fastPathBlocks{ 0 };
+
+    // how many analysers are showing right now, see addAnalyserConsumer()
+    std::atomic<int> analyserConsumers{ 0 };
+
+    // every processBlock against the time the block lasts
+    BlockLoadMeter loadMeter;
+
+
+    // linear phase mode
+    // the same curve as a symmetric FIR, designed on the design thread and
+    // run by a partitioned convolver. it has latency so switching it on or off
+    // tells the host through handleAsyncUpdate()
+    std::atomic<float>* linearPhaseMode{ apvts.getRawParameterValue("Linear Phase") };
+    LinearPhaseDesigner linearPhaseDesigner{ coefficientService, linearPhaseMode };
+    PartitionedConvolver linearPhaseConvolver;
+    std::atomic<bool> linearPhaseActive{ false };
+
+
+    // filter topology
+    // the state variable version of the chain designs its sections per sample
+    // so with smoothed automation it glides every sample instead of every controlInterval
+    std::atomic<float>* filterTopology{ apvts.getRawParameterValue("Filter Topology") };
+    SvfEngine svfCascade;
+    bool usingSvf = false;
+
+    // the band versions the svfCascade was last set to
+    std::array<juce::uint32, CoefficientSet::numBands> svfVersions{};
+
+
+    // double precision
+    // the bands in preciseBands run in the preciseCascade from the preciseStages of
+    // the sets. with a 64 bit host that is every band, with "Mixed Precision" only the
+    // ones below precisionFrequencyRatio * sampleRate where the float coefficients
+    // get too coarse (under 96 Hz at 48k, under 384 Hz at 192k)
+    static constexpr double precisionFrequencyRatio = 0.002;
+
+    BasicCascadeEngine<double> preciseCascade;
+    std::atomic<float>* mixedPrecision{ apvts.getRawParameterValue("Mixed Precision") };
+    bool processingDoubles = false;
+    std::atomic<bool> linearPhaseFallback{ false };
+    std::atomic<bool> filterTopologyFallback{ false };
+    bool usingMixedPrecision = false;
+    std::array<bool, CoefficientSet::numBands> preciseBands{};
+
+    // float blocks on their way through the preciseCascade
+    juce::AudioBuffer<double> preciseBuffer;
+    // double blocks on their way to the analyser
+    juce::AudioBuffer<float> analyserBuffer;
+    juce::AudioBuffer<double> preciseCrossfadeBuffer;
+
+
+    // with rampSamples > 0 the band glides to the new coefficients instead of jumping
+    void updatePeakFilter(const CoefficientSet& coefficients, int rampSamples = 0);
+    void updateLowCutFilter(const CoefficientSet& coefficients, int rampSamples = 0);
+    void updateHighCutFilter(const CoefficientSet& coefficients, int rampSamples = 0);
+    void updateBand(const CoefficientSet& coefficients, ChainPossitions band, int rampSamples = 0);
 
+    void applyBandToCascades(const CoefficientSet& coefficients, ChainPossitions band, int rampSamples);
+    bool shouldBePrecise(const CoefficientSet& coefficients, ChainPossitions band) const;
+    void updatePrecision(bool blockIsDouble);
 
-    void updatePeakFilter(const ChainSettings& chainSettings);
-    void updateLowCutFilter(const ChainSettings& chainSettings);
-    void updateHighCutFilter(const ChainSettings& chainSettings);
+    // the float and the double processBlock both end up here
+    template<typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
 
+    void pickUpParameterChanges();
     void updateFilters();
+    void updateSmoothedFilters();
+    void applyAllBands();
+    template<typename SampleType>
+    bool canSkipFilters(const juce::AudioBuffer<SampleType>& buffer, int numChannels);
+    void updateSleepingFilters();
+    void updateNeutralPath();
+    template<typename SampleType>
+    void applyCrossfade(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& dryBuffer, int numChannels, int numSamples);
+    template<typename SampleType, typename TickFunction, typename SegmentFunction>
+    void forEachControlSegment(juce::AudioBuffer<SampleType>& buffer, int numChannels, TickFunction&& onTick, SegmentFunction&& processSegment);
+    template<typename SampleType>
+    void processFilters(juce::AudioBuffer<SampleType>& buffer, int numChannels);
+    void runCascades(float* const* channels, int numChannels, int numSamples);
+    void runCascades(double* const* channels, int numChannels, int numSamples);
+    juce::AudioBuffer<float>& getCrossfadeBuffer(const juce::AudioBuffer<float>&);
+    juce::AudioBuffer<double>& getCrossfadeBuffer(const juce::AudioBuffer<double>&);
+    void pushToAnalyser(const juce::AudioBuffer<float>& buffer);
+    void pushToAnalyser(const juce::AudioBuffer<double>& buffer);
+    bool updateLinearPhase();
+    void updateTopology();
+    void updateSvfBands(int glideSamples);
+    void processSvf(juce::AudioBuffer<float>& buffer, int numChannels);
+    void resetFilterState();
+
+    void handleAsyncUpdate() override;
+    void setSmoothing(bool shouldSmooth);
+    template<typename SampleType>
+    void processSmoothed(juce::AudioBuffer<SampleType>& buffer, int numChannels);
         
 
     //juce::dsp::Oscillator<float> osc;
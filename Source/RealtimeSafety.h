@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.h
+    Created: 16 Oct 2026 11:46:20pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// with SIMPLEEQ_REALTIME_CHECKS set to 1 the audio callback keeps count of
+// whether the current thread is inside it, so a checking build can hook the
+// allocator and the blocking mutex calls and report every one that happens there
+// (the Benchmarks project has the hooks and a stress test, see RealtimeCheck.h).
+// without it the markers below compile to nothing
+#ifndef SIMPLEEQ_REALTIME_CHECKS
+ #define SIMPLEEQ_REALTIME_CHECKS 0
+#endif
+
+namespace RealtimeSafety
+{
+#if SIMPLEEQ_REALTIME_CHECKS
+    // how deep the current thread is inside realtime sections and allowances,
+    // plain thread locals so checking them never allocates anything itself
+    inline thread_local int sectionDepth = 0;
+    inline thread_local int allowanceDepth = 0;
+
+    inline bool isInRealtimeContext()
+    {
+        return sectionDepth > 0 && allowanceDepth == 0;
+    }
+
+    // defined by whoever installs the hooks
+    void reportViolation(const char* what);
+    int getNumViolations();
+#endif
+
+    // marks the audio callback, nothing called from in here may allocate or wait for a lock
+    struct ScopedRealtimeSection
+    {
+        ScopedRealtimeSection()
+        {
+           #if SIMPLEEQ_REALTIME_CHECKS
+            ++sectionDepth;
+           #endif
+        }
+
+        ~ScopedRealtimeSection()
+        {
+           #if SIMPLEEQ_REALTIME_CHECKS
+            --sectionDepth;
+           #endif
+        }
+    };
+
+    // a known exception inside the callback, the reason is for whoever reads the code
+    struct ScopedAllowance
+    {
+        explicit ScopedAllowance(const char* reason)
+        {
+            juce::ignoreUnused(reason);
+
+           #if SIMPLEEQ_REALTIME_CHECKS
+            ++allowanceDepth;
+           #endif
+        }
+
+        ~ScopedAllowance()
+        {
+           #if SIMPLEEQ_REALTIME_CHECKS
+            --allowanceDepth;
+           #endif
+        }
+    };
+}
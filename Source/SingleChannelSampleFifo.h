@@ -18,6 +18,12 @@ enum Channel
     Left // 1
 };
 
+// the samples of one channel go into a ring with one or two block copies per
+// block and come out again in frames of getSize() samples, so the audio thread
+// does no per sample work. one writer (the audio thread) and one reader (the editor's
+// analyser worker). prepare() can come from the message thread while the reader is
+// busy, so the two of them share the readerLock. the audio thread never takes it,
+// the host doesn't call prepare and processBlock at the same time
 template<typename BlockType>
 struct SingleChannelSampleFifo
 {
@@ -29,61 +35,131 @@ struct SingleChannelSampleFifo
     void update(const BlockType& buffer)
     {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse);
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(buffer.getNumChannels() > 0);
 
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            pushNextSampleIntoFifo(channelPtr[i]);
-        }
+        // with a mono layout there is no left channel
+        // so both analysers show the one channel there is
+        auto channel = juce::jmin(static_cast<int>(channelToUse), buffer.getNumChannels() - 1);
+        auto* channelPtr = buffer.getReadPointer(channel);
+        auto numSamples = buffer.getNumSamples();
+
+        // the reader fell behind, the analyser just misses this block
+        if (numSamples <= 0 || ring.getFreeSpace() < numSamples)
+            return;
+
+        int start1, size1, start2, size2;
+        ring.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+        juce::FloatVectorOperations::copy(samples.getWritePointer(0, start1), channelPtr, size1);
+
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy(samples.getWritePointer(0, start2), channelPtr + size1, size2);
+
+        ring.finishedWrite(size1 + size2);
     }
 
     void prepare(int bufferSize)
     {
+        const juce::ScopedLock sl(readerLock);
+
         prepared.set(false);
         size.set(bufferSize);
 
-        bufferToFill.setSize(1, // chanell
-            bufferSize,         //num samples
-            false,              // keep existing content
-            true,               // clear extra space
-            true);              // avoid reallocating
+        // room for at least 30 frames like the old buffer fifo had, and for
+        // ~0.7 s at 48k so small host blocks don't run it full between two repaints
+        auto capacity = juce::jmax(bufferSize * numFrames, minCapacity) + 1;
+
+        samples.setSize(1, // chanell
+            capacity,      // num samples
+            false,         // keep existing content
+            true,          // clear extra space
+            true);         // avoid reallocating
+        samples.clear();
 
-        audioBufferFifo.prepare(1, bufferSize);
-        fifoIndex = 0;
+        ring.setTotalSize(capacity);
+        ring.reset();
         prepared.set(true);
 
     }
 
     //==============================================================
-    int getNumCompleteBuffersAvailiable() const { return audioBufferFifo.getNumAvailiableForReading(); }
+    int getNumCompleteBuffersAvailiable() const { return ring.getNumReady() / juce::jmax(1, size.get()); }
     bool isPrepared() const { return prepared.get(); }
     int getSize() const { return size.get(); }
     //=============================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
-private:
-    Channel channelToUse;
-    int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
-    juce::Atomic<bool> prepared = false;
-    juce::Atomic<int> size = 0;
+    // the next frame of getSize() samples, if there is a whole one
+    bool getAudioBuffer(BlockType& buf)
+    {
+        // the size can't change between sizing 'buf' and filling it
+        const juce::ScopedLock sl(readerLock);
+
+        if (getNumCompleteBuffersAvailiable() == 0)
+            return false;
+
+        buf.setSize(1, size.get(), false, false, true);
+        return readFrame(buf.getWritePointer(0));
+    }
+
+    // reader side, throws away the oldest numSamples or everything that is waiting
+    void discardSamples(int numSamples)
+    {
+        const juce::ScopedLock sl(readerLock);
+        ring.finishedRead(juce::jmin(numSamples, ring.getNumReady()));
+    }
 
-    void pushNextSampleIntoFifo(float sample)
+    void discardAll()
     {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
+        const juce::ScopedLock sl(readerLock);
+        ring.finishedRead(ring.getNumReady());
+    }
 
-            juce::ignoreUnused(ok);
+    // the same straight into 'destination', which has room for getSize() samples
+    bool readFrame(float* destination)
+    {
+        const juce::ScopedLock sl(readerLock);
+        auto frameSize = size.get();
 
-            fifoIndex = 0;
-        }
+        if (frameSize <= 0 || ring.getNumReady() < frameSize)
+            return false;
 
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
+        return readSamples(destination, frameSize) == frameSize;
     }
 
+    // reader side, for whoever doesn't care about the frames.
+    // reads up to numSamples and returns how many there were, a prepare()
+    // in between the calls can leave fewer than getNumSamplesAvailable() said
+    int getNumSamplesAvailable() const
+    {
+        const juce::ScopedLock sl(readerLock);
+        return ring.getNumReady();
+    }
+
+    int readSamples(float* destination, int numSamples)
+    {
+        const juce::ScopedLock sl(readerLock);
+
+        int start1, size1, start2, size2;
+        ring.prepareToRead(numSamples, start1, size1, start2, size2);
+
+        if (size1 > 0)
+            juce::FloatVectorOperations::copy(destination, samples.getReadPointer(0, start1), size1);
 
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy(destination + size1, samples.getReadPointer(0, start2), size2);
 
-};
\ No newline at end of file
+        ring.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+private:
+    static constexpr int numFrames = 30;
+    static constexpr int minCapacity = 32768;
+
+    Channel channelToUse;
+    BlockType samples;
+    juce::AbstractFifo ring{ 1 };
+    juce::Atomic<bool> prepared = false;
+    juce::Atomic<int> size = 0;
+
+    // the reader and prepare(), see the top
+    juce::CriticalSection readerLock;
+};
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    SvfDesign.h
+    Created: 16 Oct 2026 8:41:52pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "BiquadDesign.h"
+
+// the coefficients of one topology preserving (trapezoidal) state variable
+// filter section, the way Andrew Simper describes it in "SvfLinearTrapOptimised2".
+// the section is two integrators in a loop, every response comes from
+// mixing the input (m0), the band pass (m1) and the low pass (m2) outputs.
+// it is designed from g = tan(pi * f / sr), the same prewarped frequency the
+// juce designers use, so the static responses match the biquads exactly.
+// the difference is that the state doesn't depend on the coefficients, so
+// g can change every sample without the clicks or blow ups a biquad gets
+struct SvfCoefficients
+{
+    float a1 = 1.f, a2 = 0.f, a3 = 0.f;
+    float m0 = 1.f, m1 = 0.f, m2 = 0.f;
+};
+
+// tan(x) for 0 <= x < pi/2 without calling std::tan.
+// below pi/4 it is the [5/4] pade approximant (from the continued fraction of tan),
+// above that tan(x) = 1 / tan(pi/2 - x) brings it back into that range.
+// it is as close as float gets to std::tan up to 0.49 * sr
+inline float approximateTan(float x)
+{
+    constexpr auto quarterPi = juce::MathConstants<float>::pi * 0.25f;
+
+    auto reflected = x > quarterPi;
+
+    if (reflected)
+        x = juce::MathConstants<float>::halfPi - x;
+
+    auto xSquared = x * x;
+    auto result = x * (945.f - 105.f * xSquared + xSquared * xSquared)
+        / (945.f - 420.f * xSquared + 15.f * xSquared * xSquared);
+
+    return reflected ? 1.f / result : result;
+}
+
+// the prewarped frequency of a section, frequencies too close to nyquist are clamped
+inline float getSvfFrequencyWarp(float frequency, double sampleRate)
+{
+    auto nyquistLimit = static_cast<float>(sampleRate * 0.49);
+    auto theta = juce::MathConstants<float>::pi * juce::jmin(frequency, nyquistLimit) / static_cast<float>(sampleRate);
+
+    return approximateTan(theta);
+}
+
+// k is the damping, 1 / Q for the butterworth sections
+inline SvfCoefficients makeSvfSection(float g, float k, float m0, float m1, float m2)
+{
+    SvfCoefficients coefficients;
+
+    coefficients.a1 = 1.f / (1.f + g * (g + k));
+    coefficients.a2 = g * coefficients.a1;
+    coefficients.a3 = g * coefficients.a2;
+    coefficients.m0 = m0;
+    coefficients.m1 = m1;
+    coefficients.m2 = m2;
+
+    return coefficients;
+}
+
+// same response as designHighPassSection
+inline SvfCoefficients makeSvfHighPass(float g, float Q)
+{
+    auto k = 1.f / Q;
+    return makeSvfSection(g, k, 1.f, -k, -1.f);
+}
+
+// same response as designLowPassSection
+inline SvfCoefficients makeSvfLowPass(float g, float Q)
+{
+    return makeSvfSection(g, 1.f / Q, 0.f, 0.f, 1.f);
+}
+
+// same response as designPeakSection, A is the square root of the gain factor
+inline SvfCoefficients makeSvfBell(float g, float Q, float A)
+{
+    auto k = 1.f / (Q * A);
+    return makeSvfSection(g, k, 1.f, k * (A * A - 1.f), 0.f);
+}
@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+    SvfEngine.h
+    Created: 16 Oct 2026 9:07:15pm
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "CascadeEngine.h"
+#include "SvfDesign.h"
+
+// the same 9 stage chain as the CascadeEngine but built from state variable
+// sections (see SvfDesign.h) instead of biquads.
+// the channels are packed into simd lanes the same way, and the stages are
+// laid out like a CoefficientSet: 4 low cut sections, the peak, 4 high cut sections.
+// it doesn't use the published biquad designs, it designs its sections from the
+// ChainSettings itself because a section only needs one tan to move:
+// while a band glides (see glideBand) its frequency, gain and Q move on every
+// sample and the sections get redesigned for every single one of them.
+// the redesigns happen once per modulationBlockSize samples for the whole block
+// and every group of channels reads them from there
+struct SvfEngine
+{
+    using Register = CascadeEngine::Register;
+
+    static constexpr int numLanes = CascadeEngine::numLanes;
+    static constexpr int maxChannels = CascadeEngine::maxChannels;
+    static constexpr int maxGroups = CascadeEngine::maxGroups;
+    static constexpr int numStages = CoefficientSet::numStages;
+
+    static constexpr int modulationBlockSize = 32;
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& state : states)
+        {
+            state.ic1eq.fill(Register::expand(0.f));
+            state.ic2eq.fill(Register::expand(0.f));
+        }
+    }
+
+    // jumps the band straight to the settings
+    void setBand(const ChainSettings& settings, ChainPossitions band)
+    {
+        auto& state = bands[band];
+
+        state.frequency.jumpTo(getFrequency(settings, band));
+        state.gainRoot.jumpTo(band == Peak ? getGainRoot(settings.peakGainInDecibells) : 1.f);
+        state.q.jumpTo(band == Peak ? settings.peakQ : 1.f);
+        state.samplesRemaining = 0;
+
+        state.slope = band == LowCut ? settings.lowCutSlope : settings.highCutSlope;
+        state.bypassed = isBypassed(settings, band);
+
+        forEachStage(band, [this, &state](int stage, int section)
+        {
+            active[stage] = !state.bypassed && (stage == CoefficientSet::peakStage || section < getNumSections(state.slope));
+            stride[stage] = 0;
+        });
+
+        designBand(band, 0);
+    }
+
+    // moves the frequency, gain and Q of the band to the settings over numSamples,
+    // recalculating the sections every sample. the frequencies and Q glide
+    // multiplicatively and the gain linearly in decibels, like the ChainSmoother.
+    // slope and bypass changes can't glide and jump instead
+    void glideBand(const ChainSettings& settings, ChainPossitions band, int numSamples)
+    {
+        auto& state = bands[band];
+
+        auto slope = band == LowCut ? settings.lowCutSlope : settings.highCutSlope;
+        auto canGlide = numSamples > 0 && !state.bypassed && !isBypassed(settings, band)
+            && (band == Peak || slope == state.slope);
+
+        if (!canGlide)
+        {
+            setBand(settings, band);
+            return;
+        }
+
+        state.frequency.glideTo(getFrequency(settings, band), numSamples);
+
+        if (band == Peak)
+        {
+            // a straight line in decibels is a constant ratio of the gain root
+            state.gainRoot.glideTo(getGainRoot(settings.peakGainInDecibells), numSamples);
+            state.q.glideTo(settings.peakQ, numSamples);
+        }
+
+        state.samplesRemaining = numSamples;
+    }
+
+    bool isGliding() const
+    {
+        for (const auto& state : bands)
+        {
+            if (state.samplesRemaining > 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    void process(float* const* channels, int numChannels, int numSamples)
+    {
+        jassert(numChannels <= maxChannels);
+        numChannels = juce::jmin(numChannels, maxChannels);
+
+        for (int done = 0; done < numSamples;)
+        {
+            auto numBlockSamples = juce::jmin(modulationBlockSize, numSamples - done);
+
+            for (int band = 0; band < CoefficientSet::numBands; ++band)
+                updateBand(static_cast<ChainPossitions>(band), numBlockSamples);
+
+            processGroups(channels, numChannels, done, numBlockSamples);
+            done += numBlockSamples;
+        }
+    }
+
+private:
+    // a value that moves to its target by a constant ratio every sample
+    struct Glide
+    {
+        float value = 1.f, target = 1.f, ratio = 1.f;
+
+        void jumpTo(float newValue)
+        {
+            value = target = newValue;
+            ratio = 1.f;
+        }
+
+        void glideTo(float newTarget, int numSamples)
+        {
+            target = newTarget;
+            ratio = static_cast<float>(std::pow(static_cast<double>(target) / value, 1.0 / numSamples));
+        }
+
+        void step() { value *= ratio; }
+        void land() { jumpTo(target); }
+    };
+
+    struct BandState
+    {
+        Glide frequency, gainRoot, q;
+        int samplesRemaining = 0;
+
+        Slope slope = Slope_12;
+        bool bypassed = true;
+    };
+
+    struct GroupState
+    {
+        std::array<Register, numStages> ic1eq, ic2eq;
+    };
+
+    double sampleRate = 44100.0;
+
+    std::array<BandState, CoefficientSet::numBands> bands;
+    std::array<GroupState, maxGroups> states;
+
+    // the sections of every stage for each sample of the current modulation block.
+    // a stage whose band isn't gliding only uses the first entry (stride 0)
+    std::array<std::array<SvfCoefficients, modulationBlockSize>, numStages> coefficients;
+    std::array<int, numStages> stride{};
+    std::array<bool, numStages> active{};
+
+    static bool isBypassed(const ChainSettings& settings, ChainPossitions band)
+    {
+        switch (band)
+        {
+        case LowCut:
+            return settings.lowCutBypassed;
+        case Peak:
+            return settings.peakBypassed;
+        case HighCut:
+            return settings.highCutBypassed;
+        }
+
+        return true;
+    }
+
+    static float getFrequency(const ChainSettings& settings, ChainPossitions band)
+    {
+        switch (band)
+        {
+        case LowCut:
+            return settings.lowCutFreq;
+        case Peak:
+            return settings.peakFreq;
+        case HighCut:
+            return settings.highCutFreq;
+        }
+
+        return 1000.f;
+    }
+
+    static float getGainRoot(float gainInDecibells)
+    {
+        return std::sqrt(juce::Decibels::decibelsToGain(gainInDecibells));
+    }
+
+    // writes the sections of a band for the current values into entry i
+    void designBand(ChainPossitions band, int i)
+    {
+        const auto& state = bands[band];
+        auto g = getSvfFrequencyWarp(state.frequency.value, sampleRate);
+
+        forEachStage(band, [this, &state, band, g, i](int stage, int section)
+        {
+            if (!active[stage])
+                return;
+
+            if (band == Peak)
+                coefficients[stage][i] = makeSvfBell(g, state.q.value, state.gainRoot.value);
+            else if (band == LowCut)
+                coefficients[stage][i] = makeSvfHighPass(g, butterworthQ[state.slope][section]);
+            else
+                coefficients[stage][i] = makeSvfLowPass(g, butterworthQ[state.slope][section]);
+        });
+    }
+
+    // gets the sections of a band ready for the next numSamples
+    void updateBand(ChainPossitions band, int numSamples)
+    {
+        auto& state = bands[band];
+        auto wasGliding = false;
+
+        forEachStage(band, [this, &wasGliding](int stage, int)
+        {
+            wasGliding = wasGliding || stride[stage] != 0;
+        });
+
+        if (state.samplesRemaining == 0)
+        {
+            // the glide finished in the last block, from here on one entry will do
+            if (wasGliding)
+            {
+                forEachStage(band, [this](int stage, int) { stride[stage] = 0; });
+                designBand(band, 0);
+            }
+
+            return;
+        }
+
+        forEachStage(band, [this](int stage, int) { stride[stage] = 1; });
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (state.samplesRemaining > 0)
+            {
+                // the last step lands exactly on the target
+                if (--state.samplesRemaining == 0)
+                {
+                    state.frequency.land();
+                    state.gainRoot.land();
+                    state.q.land();
+                }
+                else
+                {
+                    state.frequency.step();
+                    state.gainRoot.step();
+                    state.q.step();
+                }
+            }
+
+            designBand(band, i);
+        }
+    }
+
+    void processGroups(float* const* channels, int numChannels, int startSample, int numSamples)
+    {
+        std::array<int, numStages> activeStages;
+        int numActive = 0;
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            if (active[stage])
+                activeStages[numActive++] = stage;
+        }
+
+        if (numActive == 0)
+            return;
+
+        alignas(sizeof(Register)) float lanes[numLanes] = {};
+
+        for (int group = 0; group * numLanes < numChannels; ++group)
+        {
+            auto firstChannel = group * numLanes;
+            auto numGroupChannels = juce::jmin(numLanes, numChannels - firstChannel);
+
+            auto ic1eq = states[group].ic1eq;
+            auto ic2eq = states[group].ic2eq;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int lane = 0; lane < numGroupChannels; ++lane)
+                    lanes[lane] = channels[firstChannel + lane][startSample + i];
+
+                auto sample = Register::fromRawArray(lanes);
+
+                for (int k = 0; k < numActive; ++k)
+                {
+                    auto stage = activeStages[k];
+                    const auto& section = coefficients[stage][i * stride[stage]];
+
+                    // the two trapezoidal integrators, solved without a delay in the loop
+                    auto v3 = sample - ic2eq[stage];
+                    auto v1 = Register::expand(section.a1) * ic1eq[stage] + Register::expand(section.a2) * v3;
+                    auto v2 = ic2eq[stage] + Register::expand(section.a2) * ic1eq[stage] + Register::expand(section.a3) * v3;
+
+                    ic1eq[stage] = v1 + v1 - ic1eq[stage];
+                    ic2eq[stage] = v2 + v2 - ic2eq[stage];
+
+                    sample = Register::expand(section.m0) * sample
+                        + Register::expand(section.m1) * v1
+                        + Register::expand(section.m2) * v2;
+                }
+
+                sample.copyToRawArray(lanes);
+
+                for (int lane = 0; lane < numGroupChannels; ++lane)
+                    channels[firstChannel + lane][startSample + i] = lanes[lane];
+            }
+
+            states[group].ic1eq = ic1eq;
+            states[group].ic2eq = ic2eq;
+        }
+    }
+
+    // calls function(stage, section) for every stage of the band
+    template<typename Function>
+    static void forEachStage(ChainPossitions band, Function&& function)
+    {
+        switch (band)
+        {
+        case LowCut:
+            for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+                function(CoefficientSet::lowCutStage(i), i);
+            break;
+        case Peak:
+            function(CoefficientSet::peakStage, 0);
+            break;
+        case HighCut:
+            for (int i = 0; i < CoefficientSet::numCutStages; ++i)
+                function(CoefficientSet::highCutStage(i), i);
+            break;
+        }
+    }
+};
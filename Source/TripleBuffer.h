@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 16 Oct 2026 9:31:05am
+    Author:  User
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+
+// a single producer, single consumer "latest value" exchange
+// the writer fills its own back buffer and publishes it by swapping it with the
+// middle one, the reader swaps its front buffer with the middle one when there
+// is something new. nobody ever waits and nothing gets allocated, so the reader
+// side is safe to use on the audio thread
+template<typename T>
+struct TripleBuffer
+{
+    //==============================================================
+    // writer side
+    T& getWriteBuffer() { return buffers[backIndex]; }
+
+    void publish()
+    {
+        backIndex = middle.exchange(backIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    //==============================================================
+    // reader side
+    // returns true if a newer buffer was published since the last call
+    bool pull()
+    {
+        if ((middle.load(std::memory_order_relaxed) & newDataFlag) == 0)
+            return false;
+
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const { return buffers[frontIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int newDataFlag = 4;
+
+    std::array<T, 3> buffers;
+    int backIndex = 0;
+    int frontIndex = 1;
+    std::atomic<int> middle{ 2 };
+};